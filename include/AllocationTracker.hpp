@@ -0,0 +1,233 @@
+/**
+ * @file AllocationTracker.hpp
+ * @brief Opt-in accounting of allocations per solve phase
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ *
+ * The phases are the trace scopes (see Trace.hpp): while tracking is on,
+ * entering a TraceScope makes its name the current phase, and every
+ * allocation is charged to the current phase. Two sources are counted:
+ * - heap: calls of the global operator new, which AllocationTracker.cpp
+ *   replaces when built with NETWORKFLOW_TRACK_ALLOCATIONS defined (CMake
+ *   option NETWORKFLOW_TRACK_ALLOCATIONS=ON); otherwise heap counts stay 0,
+ * - arena: allocations of std::pmr containers in a SolveArena, through a
+ *   CountingResource.
+ *
+ * Each thread has its own current phase and adds to the counts of the
+ * AllocationScope that is current on it, so concurrent solves count
+ * separately. The worker threads of parallelTasks() and WorkerPool adopt
+ * the phase of the thread that started the work and count into scopes of
+ * their own, merged into the caller's scope when the work is done.
+ * NetworkFlow::solve() reports the allocations of the solve, including
+ * nested solves, in Solution::allocations.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+/**
+ * @struct PhaseAllocations
+ * @brief Allocations charged to one phase
+ */
+struct PhaseAllocations {
+    std::string phase; ///< Trace scope name, "other" outside any scope
+    uint64_t heapCalls = 0;
+    uint64_t heapBytes = 0;
+    uint64_t arenaCalls = 0;
+    uint64_t arenaBytes = 0;
+};
+
+/**
+ * @class AllocationTracker
+ * @brief Phase table and routing of each thread's allocations
+ */
+class AllocationTracker {
+public:
+    /// Most distinct phase names; later ones are charged to "other"
+    static constexpr size_t MAX_PHASES = 64;
+
+    /// Whether the global operator new is replaced to count heap calls
+#ifdef NETWORKFLOW_TRACK_ALLOCATIONS
+    static constexpr bool HEAP_HOOKED = true;
+#else
+    static constexpr bool HEAP_HOOKED = false;
+#endif
+
+    /**
+     * @struct Totals
+     * @brief Counts of every phase, kept without allocating
+     */
+    struct Totals {
+        uint64_t heapCalls[MAX_PHASES] = {};
+        uint64_t heapBytes[MAX_PHASES] = {};
+        uint64_t arenaCalls[MAX_PHASES] = {};
+        uint64_t arenaBytes[MAX_PHASES] = {};
+    };
+
+private:
+    static std::atomic<bool> active;
+    inline static thread_local int current = 0;
+    inline static thread_local Totals *local = nullptr;
+
+    static void charge(bool heap, size_t bytes);
+
+public:
+    /**
+     * @brief Start counting allocations
+     */
+    static void start();
+
+    /**
+     * @brief Stop counting, keeping the counts
+     */
+    static void stop();
+
+    /**
+     * @brief Check whether allocations are counted
+     * @return True between start() and stop()
+     */
+    static bool enabled() { return active.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Make a phase current
+     * @param phase Phase name, a string literal or otherwise never freed
+     * @return Token of the previous phase, for leave()
+     */
+    static int enter(const char *phase);
+
+    /**
+     * @brief Return to the phase that was current before enter()
+     * @param previous Token returned by enter()
+     */
+    static void leave(int previous) { current = previous; }
+
+    /**
+     * @brief Phase current on the calling thread
+     * @return Token for adopt() on another thread
+     */
+    static int phase() { return current; }
+
+    /**
+     * @brief Make the calling thread charge another thread's phase
+     * @param token Result of phase() on that thread
+     */
+    static void adopt(int token) { current = token; }
+
+    /**
+     * @brief Charge a heap allocation to the current phase
+     * @param bytes Requested size
+     */
+    static void countHeap(size_t bytes) {
+        if (enabled())
+            charge(true, bytes);
+    }
+
+    /**
+     * @brief Charge an arena allocation to the current phase
+     * @param bytes Requested size
+     */
+    static void countArena(size_t bytes) {
+        if (enabled())
+            charge(false, bytes);
+    }
+
+    /**
+     * @brief Counts the calling thread adds to
+     * @return Current counts, or null if allocations are not recorded
+     */
+    static Totals *scope() { return local; }
+
+    /**
+     * @brief Make the calling thread add to other counts
+     * @param counts Counts owned by the calling thread, or null to stop
+     *        recording
+     * @return Counts that were current before
+     */
+    static Totals *redirect(Totals *counts) {
+        Totals *previous = local;
+        local = counts;
+        return previous;
+    }
+
+    /**
+     * @brief Add counts of finished work to the calling thread's counts
+     * @param counts Counts collected elsewhere, e.g. by a worker thread
+     */
+    static void merge(const Totals &counts);
+
+    /**
+     * @brief Name the phases of counts
+     * @param counts Counts of a scope
+     * @return Phases that allocated, in order of first use
+     */
+    static std::vector<PhaseAllocations> report(const Totals &counts);
+};
+
+/**
+ * @class AllocationScope
+ * @brief Collects the allocations of the calling thread while it lives
+ *
+ * Scopes nest: when a scope ends, its counts are added to the scope that
+ * was current before, so an outer solve includes its nested solves.
+ */
+class AllocationScope {
+private:
+    AllocationTracker::Totals counts;
+    AllocationTracker::Totals *previous;
+
+public:
+    AllocationScope() : previous(AllocationTracker::redirect(&counts)) {}
+
+    ~AllocationScope() {
+        AllocationTracker::redirect(previous);
+        AllocationTracker::merge(counts);
+    }
+
+    /**
+     * @brief Allocations counted so far in this scope
+     * @return Phases that allocated, including on worker threads
+     */
+    std::vector<PhaseAllocations> report() const {
+        return AllocationTracker::report(counts);
+    }
+
+    AllocationScope(const AllocationScope &) = delete;
+    AllocationScope &operator=(const AllocationScope &) = delete;
+};
+
+/**
+ * @class CountingResource
+ * @brief Memory resource that charges allocations to the current phase
+ */
+class CountingResource : public std::pmr::memory_resource {
+private:
+    std::pmr::memory_resource *upstream;
+
+    void *do_allocate(size_t bytes, size_t alignment) override {
+        AllocationTracker::countArena(bytes);
+        return upstream->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+        upstream->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(
+        const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+
+public:
+    /**
+     * @brief Wrap a resource
+     * @param resource Resource that serves the allocations
+     */
+    explicit CountingResource(std::pmr::memory_resource *resource)
+        : upstream(resource) {}
+};
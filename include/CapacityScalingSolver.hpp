@@ -0,0 +1,43 @@
+/**
+ * @file CapacityScalingSolver.hpp
+ * @brief Native capacity scaling successive shortest path solver
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ */
+
+#pragma once
+
+#include "NetworkFlow.hpp"
+
+/**
+ * @class CapacityScalingSolver
+ * @brief Minimum cost flow by capacity scaling
+ *
+ * Flow is sent in units of a scaling parameter Delta that starts at the
+ * largest power of two not above the largest supply or demand and halves
+ * every phase. Within a phase, Dijkstra's algorithm on reduced costs finds
+ * a shortest path from a node with at least Delta surplus to a node with
+ * at least Delta deficit, and at least Delta units are augmented along it.
+ *
+ * The number of shortest path computations grows with log(max supply)
+ * rather than with the supply itself, which suits networks that move
+ * millions of units. All arithmetic is on integers after decimal scaling.
+ */
+class CapacityScalingSolver {
+private:
+    const NetworkFlow &net;
+
+public:
+    /**
+     * @brief Construct a solver for a network
+     * @param network Network to solve, must outlive the solver
+     */
+    explicit CapacityScalingSolver(const NetworkFlow &network);
+
+    /**
+     * @brief Solve the network
+     * @param options Solve options (threads, warm-start potentials)
+     * @return Solution with flows and optimal potentials
+     */
+    Solution solve(const SolveOptions &options) const;
+};
@@ -0,0 +1,76 @@
+/**
+ * @file Condensation.hpp
+ * @brief Strongly connected components and the condensation DAG
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ *
+ * Cycles never leave a strongly connected component, and the components
+ * themselves form a DAG. Kernels use this to skip work: negative cycles
+ * are only searched inside components, and shortest paths cross the DAG
+ * in a single topological sweep.
+ */
+
+#pragma once
+
+#include "FlowGraph.hpp"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @struct Condensation
+ * @brief Strongly connected components of a FlowGraph
+ *
+ * Components are numbered in topological order: every arc between two
+ * components leads from a lower to a higher number. The nodes of component
+ * c are nodes[begin[c] .. begin[c+1]).
+ */
+struct Condensation {
+    int numComponents;
+    std::vector<int> component; ///< Component per node
+    std::vector<size_t> begin;  ///< Start of each component in nodes
+    std::vector<int> nodes;     ///< Nodes grouped by component
+    size_t innerArcs;           ///< Arcs inside a component, loops included
+
+    /**
+     * @brief Analysis of the empty graph
+     */
+    Condensation() : numComponents(0), begin(1, 0), innerArcs(0) {}
+
+    /**
+     * @brief Compute the components
+     * @param g Graph
+     *
+     * Iterative Tarjan's algorithm, linear in the graph size.
+     */
+    explicit Condensation(const FlowGraph &g);
+
+    /**
+     * @brief Check whether the graph has no cycle at all
+     * @return True if every component is a single node without a loop
+     */
+    bool acyclic() const { return innerArcs == 0; }
+
+    /**
+     * @brief Number of nodes in a component
+     * @param c Component
+     * @return Node count
+     */
+    size_t size(int c) const { return begin[c + 1] - begin[c]; }
+
+    /**
+     * @brief Number of nodes in the largest component
+     * @return Node count, 0 for an empty graph
+     */
+    size_t largest() const;
+};
+
+/**
+ * @brief Subgraph of the arcs that lie inside components
+ * @param g Graph
+ * @param cond Components of g
+ * @param arcs Receives the arc of g for each arc of the subgraph
+ * @param threads Worker threads, 0 for hardware concurrency
+ * @return Graph on the same nodes holding only arcs that can lie on cycles
+ */
+FlowGraph innerSubgraph(const FlowGraph &g, const Condensation &cond,
+                        std::vector<size_t> &arcs, unsigned threads = 0);
@@ -0,0 +1,176 @@
+/**
+ * @file ContractionHierarchy.hpp
+ * @brief Contraction hierarchy for repeated shortest path queries
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ *
+ * The hierarchy depends on the topology only, so it is built once, saved
+ * next to the instance and reused while costs and balances change. Each
+ * solve customizes it to the current costs, which takes one pass over the
+ * hierarchy, and then answers point-to-point queries by scanning a few
+ * hundred nodes instead of the whole graph.
+ */
+
+#pragma once
+
+#include "FlowGraph.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @struct HierarchyMetric
+ * @brief Costs of the hierarchy edges for one cost vector
+ *
+ * Hierarchy edge e joins a lower ranked node to a higher ranked one. Its
+ * upward direction (lower to higher) and downward direction each have a
+ * length, and either an original arc of that length or the lower ranked
+ * node the shortcut passes through.
+ */
+struct HierarchyMetric {
+    std::vector<long long> upLength;
+    std::vector<long long> downLength;
+    std::vector<size_t> upArc;   ///< Original arc, NO_ARC for a shortcut
+    std::vector<size_t> downArc; ///< Original arc, NO_ARC for a shortcut
+    std::vector<int> upVia;      ///< Middle node of a shortcut
+    std::vector<int> downVia;    ///< Middle node of a shortcut
+};
+
+/**
+ * @struct HierarchySearch
+ * @brief Labels of one node and its ancestors in the elimination tree
+ *
+ * A forward search holds distances from the start node, a backward search
+ * distances to it. Nodes are in increasing rank order.
+ */
+struct HierarchySearch {
+    std::vector<int> node;
+    std::vector<int> rank;
+    std::vector<long long> dist; ///< unreachableDistance() if not reached
+    std::vector<size_t> edge;    ///< Hierarchy edge of the label, NO_ARC
+};
+
+/**
+ * @class ContractionHierarchy
+ * @brief Customizable contraction hierarchy of a FlowGraph topology
+ *
+ * Nodes are contracted in nested dissection order of the undirected
+ * topology, separators after the parts they separate. Contracting a node
+ * joins all its remaining neighbours pairwise, and its edges to them
+ * become its upward edges. Every upward neighbour of a node is an ancestor
+ * in the elimination tree (parent = lowest ranked upward neighbour), so a
+ * search only relaxes the upward edges of the start node and its
+ * ancestors, in rank order, and works with negative lengths too.
+ *
+ * Graphs without small separators (e.g. random graphs) produce too many
+ * shortcuts; construction then stops at the fill limit and the hierarchy
+ * is empty(), telling callers to fall back to plain searches.
+ */
+class ContractionHierarchy {
+private:
+    uint64_t hash;
+    int numNodes;
+    bool complete;
+    std::vector<int> rank;
+    std::vector<int> parent;
+    std::vector<size_t> upBegin;
+    std::vector<int> upNode;  ///< Upper endpoint per edge, by rank per list
+    std::vector<int> edgeLow; ///< Lower endpoint per edge
+
+    ContractionHierarchy();
+
+    void finish();
+    size_t findEdge(int low, int high) const;
+    void relax(HierarchyMetric &metric, size_t arc, int from, int to,
+               long long length) const;
+    void unpack(const HierarchyMetric &metric, size_t e, bool up,
+                std::vector<size_t> &arcs) const;
+
+public:
+    /**
+     * @brief Contract the topology of a graph
+     * @param g Graph topology
+     * @param maxFill Give up once the hierarchy would have more than
+     *        maxFill times as many edges as the undirected topology
+     */
+    explicit ContractionHierarchy(const FlowGraph &g, double maxFill = 16.0);
+
+    /**
+     * @brief Read a hierarchy written by save()
+     * @param path File to read
+     * @return Hierarchy stored in the file
+     * @throws std::runtime_error If the file cannot be read or is invalid
+     */
+    static ContractionHierarchy load(const std::string &path);
+
+    /**
+     * @brief Write the hierarchy to a binary file
+     * @param path File to write
+     * @throws std::runtime_error If the file cannot be written
+     *
+     * Abandoned hierarchies are saved too, so that callers do not retry
+     * building them for the same topology.
+     */
+    void save(const std::string &path) const;
+
+    /**
+     * @brief Check whether construction gave up at the fill limit
+     * @return True if the hierarchy cannot answer queries
+     */
+    bool empty() const { return !complete; }
+
+    /**
+     * @brief Check whether the hierarchy was built for a graph's topology
+     * @param g Graph topology
+     * @return True if node count and arcs match
+     */
+    bool matches(const FlowGraph &g) const;
+
+    /**
+     * @brief Number of hierarchy edges
+     * @return Edge count, including shortcuts
+     */
+    size_t numEdges() const { return upNode.size(); }
+
+    /**
+     * @brief Compute the hierarchy edge lengths for a cost vector
+     * @param g Graph topology the hierarchy matches
+     * @param cost Cost per arc, without negative cycles
+     * @return Metric for search() and path()
+     * @throws std::runtime_error If an arc has no hierarchy edge
+     */
+    HierarchyMetric customize(const FlowGraph &g,
+                              const std::vector<long long> &cost) const;
+
+    /**
+     * @brief Search from or to a node
+     * @param metric Edge lengths from customize()
+     * @param v Start node (0-indexed)
+     * @param forward True for distances from v, false for distances to v
+     * @param result Receives the labels
+     */
+    void search(const HierarchyMetric &metric, int v, bool forward,
+                HierarchySearch &result) const;
+
+    /**
+     * @brief Length of a shortest path
+     * @param from Forward search of the first node
+     * @param to Backward search of the last node
+     * @param meeting Receives the highest ranked node of the path, or -1
+     * @return Path length, unreachableDistance() if there is no path
+     */
+    long long distance(const HierarchySearch &from, const HierarchySearch &to,
+                       int *meeting = nullptr) const;
+
+    /**
+     * @brief Append the arcs of a shortest path
+     * @param metric Edge lengths the searches used
+     * @param from Forward search of the first node
+     * @param to Backward search of the last node
+     * @param arcs Receives the original arcs of the path, in order
+     * @return False if there is no path
+     */
+    bool path(const HierarchyMetric &metric, const HierarchySearch &from,
+              const HierarchySearch &to, std::vector<size_t> &arcs) const;
+};
@@ -0,0 +1,157 @@
+/**
+ * @file Counters.hpp
+ * @brief Counts of algorithmic events, reported with every solution
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ *
+ * Engines call EventCounters::add() for the steps that explain their
+ * running time: pivots and how many of them were degenerate, arcs priced,
+ * pushes, relabels, augmentations and heap operations. Events go to the
+ * CounterScope that is current on the calling thread, so concurrent solves
+ * count separately, and each thread adds to its own counts, so counting
+ * needs no atomic read-modify-write and no shared cache line.
+ * parallelTasks() and WorkerPool give their worker threads counts of their
+ * own and merge them into the caller's scope when the work is done.
+ * NetworkFlow::solve() reports the events of the solve, including nested
+ * solves, in Solution::counters.
+ *
+ * Building with NETWORKFLOW_NO_COUNTERS defined (CMake option
+ * NETWORKFLOW_COUNTERS=OFF) compiles every add() to nothing, and all
+ * counters read zero.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @enum Counter
+ * @brief Kind of algorithmic event
+ */
+enum class Counter {
+    Pivots,           ///< Basis changes (CPLEX: simplex iterations)
+    DegeneratePivots, ///< Pivots that moved no flow
+    ArcsPriced,       ///< Reduced costs computed to choose entering arcs
+    Pushes,           ///< Flow moved along a single arc
+    Relabels,         ///< Node potentials changed
+    Augmentations,    ///< Flow sent along a whole path or cycle
+    HeapPushes,       ///< Insertions into a priority queue
+    HeapPops          ///< Removals from a priority queue
+};
+
+/// Number of Counter kinds
+constexpr size_t COUNTER_KINDS = static_cast<size_t>(Counter::HeapPops) + 1;
+
+/**
+ * @struct SolveCounters
+ * @brief Event counts of one solve, indexed by Counter
+ */
+struct SolveCounters {
+    uint64_t values[COUNTER_KINDS] = {};
+
+    uint64_t operator[](Counter c) const {
+        return values[static_cast<size_t>(c)];
+    }
+
+    uint64_t &operator[](Counter c) { return values[static_cast<size_t>(c)]; }
+
+    /**
+     * @brief Name of a counter for reports
+     * @param c Counter kind
+     * @return Snake case name such as "degenerate_pivots"
+     */
+    static const char *name(Counter c);
+};
+
+/**
+ * @class EventCounters
+ * @brief Routing of each thread's events to its current counts
+ *
+ * Events on a thread without current counts are not recorded.
+ */
+class EventCounters {
+public:
+    /// False when counting is compiled out
+#ifdef NETWORKFLOW_NO_COUNTERS
+    static constexpr bool ENABLED = false;
+#else
+    static constexpr bool ENABLED = true;
+#endif
+
+private:
+    inline static thread_local SolveCounters *local = nullptr;
+
+public:
+    /**
+     * @brief Count events on the calling thread
+     * @param c Counter kind
+     * @param count Number of events
+     */
+    static void add(Counter c, uint64_t count = 1) {
+        if constexpr (ENABLED) {
+            if (local)
+                (*local)[c] += count;
+        }
+    }
+
+    /**
+     * @brief Counts the calling thread adds to
+     * @return Current counts, or null if events are not recorded
+     */
+    static SolveCounters *current() { return local; }
+
+    /**
+     * @brief Make the calling thread add to other counts
+     * @param counts Counts owned by the calling thread, or null to stop
+     *        recording
+     * @return Counts that were current before
+     */
+    static SolveCounters *redirect(SolveCounters *counts) {
+        SolveCounters *previous = local;
+        local = counts;
+        return previous;
+    }
+
+    /**
+     * @brief Add counts of finished work to the calling thread's counts
+     * @param counts Counts collected elsewhere, e.g. by a worker thread
+     */
+    static void merge(const SolveCounters &counts) {
+        if constexpr (ENABLED) {
+            if (local)
+                for (size_t k = 0; k < COUNTER_KINDS; ++k)
+                    local->values[k] += counts.values[k];
+        }
+    }
+};
+
+/**
+ * @class CounterScope
+ * @brief Collects the events of the calling thread while it lives
+ *
+ * Scopes nest: when a scope ends, its counts are added to the scope that
+ * was current before, so an outer solve includes its nested solves.
+ */
+class CounterScope {
+private:
+    SolveCounters counts;
+    SolveCounters *previous;
+
+public:
+    CounterScope() : previous(EventCounters::redirect(&counts)) {}
+
+    ~CounterScope() {
+        EventCounters::redirect(previous);
+        EventCounters::merge(counts);
+    }
+
+    /**
+     * @brief Events counted so far in this scope
+     * @return Counts, including those merged from worker threads
+     */
+    const SolveCounters &get() const { return counts; }
+
+    CounterScope(const CounterScope &) = delete;
+    CounterScope &operator=(const CounterScope &) = delete;
+};
@@ -0,0 +1,164 @@
+/**
+ * @file EdgeStore.hpp
+ * @brief Memory-mapped on-disk edge lists for networks larger than RAM
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ *
+ * Edges are stored in fixed-size blocks, each holding the from, to and cost
+ * columns of EDGE_BLOCK consecutive edges. Consumers see the edges as a
+ * sequence of such blocks, so a sweep reads the file front to back and
+ * every block fits in the L2 cache. A memory budget bounds how much of the
+ * mapping is resident at a time; pages behind the sweep are dropped and the
+ * next window is prefetched, so a network that does not fit in memory makes
+ * a solve I/O bound instead of failing with bad_alloc.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+/// Edges per block of an edge sweep, and per block of an edge store file
+constexpr size_t EDGE_BLOCK = size_t(1) << 16;
+
+/**
+ * @struct EdgeBlock
+ * @brief Consecutive edges in structure-of-arrays form
+ *
+ * Node indices are 1-indexed as in NetworkFlow. The arrays are only valid
+ * during the callback that receives the block.
+ */
+struct EdgeBlock {
+    size_t first; ///< Index of the first edge of the block
+    size_t count; ///< Number of edges, at most EDGE_BLOCK
+    const int *from;
+    const int *to;
+    const double *cost;
+};
+
+/// Callback of an edge sweep
+using EdgeSweep = std::function<void(const EdgeBlock &)>;
+
+/**
+ * @class EdgeStoreWriter
+ * @brief Appends edges to a new edge store file
+ *
+ * Only one block is buffered in memory. The file is complete once finish()
+ * returns; a writer destroyed before that leaves an invalid file.
+ */
+class EdgeStoreWriter {
+private:
+    std::string path;
+    int fd;
+    size_t count;
+    int minNode;
+    int maxNode;
+    std::vector<int> from;
+    std::vector<int> to;
+    std::vector<double> cost;
+
+    void flush();
+
+public:
+    /**
+     * @brief Create or truncate a store file
+     * @param filePath File to write
+     * @throws std::runtime_error If the file cannot be created
+     */
+    explicit EdgeStoreWriter(const std::string &filePath);
+    ~EdgeStoreWriter();
+
+    EdgeStoreWriter(const EdgeStoreWriter &) = delete;
+    EdgeStoreWriter &operator=(const EdgeStoreWriter &) = delete;
+
+    /**
+     * @brief Append edges stored as parallel arrays
+     * @param from Source node indices (1-indexed)
+     * @param to Destination node indices (1-indexed)
+     * @param cost Costs per unit of flow
+     * @param n Number of edges in the arrays
+     * @throws std::runtime_error If writing fails
+     */
+    void append(const int *from, const int *to, const double *cost, size_t n);
+
+    /**
+     * @brief Write the last block and the header, then close the file
+     * @throws std::runtime_error If writing fails
+     */
+    void finish();
+};
+
+/**
+ * @class EdgeStore
+ * @brief Read-only mapping of an edge store file
+ *
+ * The mapping covers the whole file, but sweep() keeps at most about
+ * memoryBudget() bytes of it resident. Stores are immutable and may be
+ * shared by several networks and threads.
+ */
+class EdgeStore {
+private:
+    std::string path;
+    const char *data;
+    size_t length;
+    size_t count;
+    int minNode;
+    int maxNode;
+    size_t budget;
+
+public:
+    /// Resident bytes of a sweep when no budget is given
+    static constexpr size_t DEFAULT_BUDGET = size_t(1) << 30;
+
+    /**
+     * @brief Map a store written by EdgeStoreWriter
+     * @param filePath File to read
+     * @param memoryBudget Bytes of the file a sweep may keep resident
+     * @throws std::runtime_error If the file cannot be read or is invalid
+     */
+    explicit EdgeStore(const std::string &filePath,
+                       size_t memoryBudget = DEFAULT_BUDGET);
+    ~EdgeStore();
+
+    EdgeStore(const EdgeStore &) = delete;
+    EdgeStore &operator=(const EdgeStore &) = delete;
+
+    /**
+     * @brief Number of edges in the store
+     * @return Edge count
+     */
+    size_t size() const { return count; }
+
+    /**
+     * @brief Smallest node index of any edge
+     * @return Node index, 0 for an empty store
+     */
+    int lowestNode() const { return minNode; }
+
+    /**
+     * @brief Largest node index of any edge
+     * @return Node index, 0 for an empty store
+     */
+    int highestNode() const { return maxNode; }
+
+    /**
+     * @brief Bytes of the file a sweep keeps resident
+     * @return Memory budget
+     */
+    size_t memoryBudget() const { return budget; }
+
+    /**
+     * @brief Visit all edges block by block
+     * @param fn Callback receiving each block once
+     * @param threads Worker threads, 0 for hardware concurrency
+     *
+     * The file is processed in windows of half the budget; the next window
+     * is prefetched while the current one is processed. Within a window
+     * blocks are handed to up to threads threads, so fn must be safe to
+     * call concurrently unless threads is 1, in which case blocks arrive in
+     * edge order on the calling thread.
+     */
+    void sweep(const EdgeSweep &fn, unsigned threads = 1) const;
+};
@@ -0,0 +1,85 @@
+/**
+ * @file FlowGraph.hpp
+ * @brief Compressed sparse row view of a NetworkFlow graph
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ *
+ * Graph kernels (validation, shortest paths, native solvers) work on this
+ * 0-indexed structure-of-arrays copy of the network instead of the
+ * user-facing vector<Edge>.
+ */
+
+#pragma once
+
+#include "NetworkFlow.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @struct FlowGraph
+ * @brief Arc arrays plus outgoing and incoming adjacency in CSR form
+ *
+ * Arc a corresponds to NetworkFlow::getEdges()[a]; its endpoints are stored
+ * 0-indexed. The arcs leaving node v are outArcs[outBegin[v] .. outBegin[v+1])
+ * and the arcs entering it are inArcs[inBegin[v] .. inBegin[v+1]), both in
+ * increasing arc order.
+ */
+struct FlowGraph {
+    int numNodes;
+    std::vector<int> source;
+    std::vector<int> target;
+    std::vector<double> cost;
+    std::vector<size_t> outBegin;
+    std::vector<size_t> outArcs;
+    std::vector<size_t> inBegin;
+    std::vector<size_t> inArcs;
+
+    /**
+     * @brief Build the CSR view of a network
+     * @param net Source network
+     * @param threads Worker threads, 0 for hardware concurrency
+     *
+     * Arcs are counted and scattered in parallel; each adjacency list is
+     * then sorted by arc index so the layout does not depend on scheduling.
+     */
+    explicit FlowGraph(const NetworkFlow &net, unsigned threads = 0);
+
+    /**
+     * @brief Build the CSR view of arcs given as arrays
+     * @param n Number of nodes
+     * @param arcSource Tail of each arc (0-indexed)
+     * @param arcTarget Head of each arc (0-indexed)
+     * @param arcCost Cost of each arc
+     * @param threads Worker threads, 0 for hardware concurrency
+     */
+    FlowGraph(int n, std::vector<int> arcSource, std::vector<int> arcTarget,
+              std::vector<double> arcCost, unsigned threads = 0);
+
+    /**
+     * @brief Number of arcs
+     * @return Arc count
+     */
+    size_t numArcs() const { return source.size(); }
+
+private:
+    void buildAdjacency(unsigned threads);
+};
+
+/**
+ * @brief Fingerprint of a graph's topology
+ * @param g Graph to hash
+ * @return 64-bit FNV-1a hash of the node count and the arc endpoints
+ *
+ * Costs are not included, so data derived from the topology alone can be
+ * checked against a graph whose costs have changed since.
+ */
+uint64_t topologyHash(const FlowGraph &g);
+
+/**
+ * @brief Fingerprint of a network's topology
+ * @param net Network to hash
+ * @return Same value as topologyHash(FlowGraph(net)), computed in one
+ *         sequential sweep over the edges without building the graph
+ */
+uint64_t topologyHash(const NetworkFlow &net);
@@ -0,0 +1,92 @@
+/**
+ * @file InstanceReader.hpp
+ * @brief Parallel readers for network flow instance files
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ *
+ * Instance files are memory-mapped and split into chunks at line boundaries.
+ * Every chunk is parsed on its own thread into structure-of-arrays buffers,
+ * which are then appended to the NetworkFlow edges in file order. With an
+ * edge store path, the file is parsed in windows that fit the memory budget
+ * and each window is written to the store before the next one is read.
+ */
+
+#pragma once
+
+#include "NetworkFlow.hpp"
+#include <cstddef>
+#include <string>
+
+/**
+ * @enum InstanceFormat
+ * @brief Text formats understood by readInstance()
+ */
+enum class InstanceFormat {
+    /**
+     * DIMACS minimum cost flow format:
+     * - "p min <nodes> <arcs>" problem line
+     * - "n <id> <supply>" node lines
+     * - "a <from> <to> <low> <cap> <cost>" arc lines
+     * - "c ..." comment lines
+     *
+     * Lower bounds must be zero. Arcs are modelled as uncapacitated, so
+     * every capacity must be at least the total supply, which no arc flow
+     * needs to exceed; instances with smaller capacities are rejected.
+     */
+    Dimacs,
+    /**
+     * Comma separated edge list with one "from,to,cost" row per edge and an
+     * optional header row. The node count is the largest node id seen and
+     * all balances start at zero.
+     */
+    Csv
+};
+
+/**
+ * @struct ReaderOptions
+ * @brief Settings for the parallel instance reader
+ */
+struct ReaderOptions {
+    unsigned threads;     ///< Parser threads, 0 for hardware concurrency
+    size_t minChunkBytes; ///< Smallest slice of the file given to a thread
+    /**
+     * Edge store file to write the edges to, see EdgeStore.hpp. Empty to
+     * keep the edges in memory.
+     */
+    std::string edgeStorePath;
+    /**
+     * Bytes of parsed edges held in memory while writing the edge store,
+     * and the resident budget of the resulting store. Ignored without an
+     * edge store path.
+     */
+    size_t memoryBudget;
+
+    /**
+     * @brief Default constructor
+     * Uses all hardware threads with chunks of at least 4 MiB and keeps the
+     * edges in memory
+     */
+    ReaderOptions()
+        : threads(0), minChunkBytes(size_t(4) << 20),
+          memoryBudget(EdgeStore::DEFAULT_BUDGET) {}
+};
+
+/**
+ * @brief Read a network flow instance from a file
+ * @param path Path to the instance file
+ * @param format File format
+ * @param opts Reader options
+ * @return Network with all nodes, balances and edges from the file
+ * @throws std::runtime_error If the file cannot be read or is malformed;
+ *         the message names the offending line
+ */
+NetworkFlow readInstance(const std::string &path, InstanceFormat format,
+                         const ReaderOptions &opts = ReaderOptions());
+
+/**
+ * @brief Guess the instance format from a file name extension
+ * @param path File name ending in .csv, .min, .dimacs or .net
+ * @return Matching instance format
+ * @throws std::invalid_argument If the extension is not recognised
+ */
+InstanceFormat instanceFormatFromPath(const std::string &path);
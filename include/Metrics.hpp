@@ -0,0 +1,218 @@
+/**
+ * @file Metrics.hpp
+ * @brief Process-wide counters and histograms in Prometheus text format
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ *
+ * Metrics are registered once by name and labels, which takes a lock, and
+ * updated through the returned reference with relaxed atomic additions
+ * only. Histograms use HDR-style log-linear buckets: every power of two is
+ * split into SUB_BUCKETS equal buckets, so any value is recorded with a
+ * relative error below 1 / SUB_BUCKETS without configuring bucket bounds.
+ *
+ * The registry is rendered in the Prometheus exposition format, either on
+ * demand, periodically to a file, or to a local scraper over TCP through
+ * a MetricsExporter.
+ *
+ * NetworkFlow::solve() records:
+ * - networkflow_solves_total{backend, outcome}
+ * - networkflow_solve_seconds{backend}
+ * - networkflow_solve_nodes and networkflow_solve_edges (instance size)
+ * - networkflow_distance_cache_lookups_total{result}
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @class MetricCounter
+ * @brief Monotonic counter
+ */
+class MetricCounter {
+private:
+    std::atomic<uint64_t> value{0};
+
+public:
+    /**
+     * @brief Count events
+     * @param count Number of events
+     */
+    void add(uint64_t count = 1) {
+        value.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Current value
+     * @return Events counted so far
+     */
+    uint64_t get() const { return value.load(std::memory_order_relaxed); }
+};
+
+/**
+ * @class MetricHistogram
+ * @brief Distribution of non-negative integer samples
+ */
+class MetricHistogram {
+public:
+    /// log2 of the number of buckets per power of two
+    static constexpr unsigned SUB_BITS = 3;
+    /// Buckets per power of two
+    static constexpr size_t SUB_BUCKETS = size_t(1) << SUB_BITS;
+    /// Buckets covering all of uint64_t
+    static constexpr size_t BUCKETS = (64 - SUB_BITS + 1) * SUB_BUCKETS;
+
+private:
+    std::atomic<uint64_t> counts[BUCKETS] = {};
+    std::atomic<uint64_t> total{0};
+    double unit;
+
+public:
+    /**
+     * @brief Create an empty histogram
+     * @param sampleUnit Value of one sample unit in the exported unit,
+     *        e.g. 1e-9 for samples in nanoseconds exported as seconds
+     */
+    explicit MetricHistogram(double sampleUnit = 1.0) : unit(sampleUnit) {}
+
+    /**
+     * @brief Bucket of a sample
+     * @param value Sample
+     * @return Bucket index in [0, BUCKETS)
+     */
+    static size_t bucket(uint64_t value) {
+        if (value < SUB_BUCKETS)
+            return static_cast<size_t>(value);
+        const unsigned exponent = 63 - __builtin_clzll(value);
+        const unsigned shift = exponent - SUB_BITS;
+        return (shift + 1) * SUB_BUCKETS +
+               static_cast<size_t>((value >> shift) & (SUB_BUCKETS - 1));
+    }
+
+    /**
+     * @brief Largest sample of a bucket
+     * @param index Bucket index
+     * @return Inclusive upper bound of the bucket in sample units
+     */
+    static uint64_t upperBound(size_t index);
+
+    /**
+     * @brief Record a sample
+     * @param value Sample in sample units
+     */
+    void record(uint64_t value) {
+        counts[bucket(value)].fetch_add(1, std::memory_order_relaxed);
+        total.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Append the histogram as Prometheus sample lines
+     * @param out Output text
+     * @param name Metric family name
+     * @param labels Rendered labels without braces, possibly empty
+     *
+     * Only buckets holding samples get a line, so the output stays short
+     * although the bucket range is unbounded.
+     */
+    void render(std::string &out, const std::string &name,
+                const std::string &labels) const;
+};
+
+/**
+ * @class Metrics
+ * @brief Registry of all metrics of the process
+ */
+class Metrics {
+public:
+    using Labels = std::vector<std::pair<std::string, std::string>>;
+
+    /**
+     * @brief Find or create a counter
+     * @param name Metric family name, e.g. "networkflow_solves_total"
+     * @param help Description for the HELP line
+     * @param labels Label names and values of this series
+     * @return Counter that lives as long as the process
+     * @throws std::logic_error If the name is registered as a histogram
+     */
+    static MetricCounter &counter(const std::string &name,
+                                  const std::string &help,
+                                  const Labels &labels = {});
+
+    /**
+     * @brief Find or create a histogram
+     * @param name Metric family name, e.g. "networkflow_solve_seconds"
+     * @param help Description for the HELP line
+     * @param unit Value of one sample unit in the exported unit
+     * @param labels Label names and values of this series
+     * @return Histogram that lives as long as the process
+     * @throws std::logic_error If the name is registered as a counter
+     */
+    static MetricHistogram &histogram(const std::string &name,
+                                      const std::string &help, double unit,
+                                      const Labels &labels = {});
+
+    /**
+     * @brief Render every metric
+     * @return Prometheus text exposition format, version 0.0.4
+     */
+    static std::string exposition();
+
+    /**
+     * @brief Write the exposition to a file
+     * @param path File to replace; written to path + ".tmp" and renamed,
+     *        so readers never see a partial file
+     * @throws std::runtime_error If the file cannot be written
+     */
+    static void write(const std::string &path);
+};
+
+/**
+ * @class MetricsExporter
+ * @brief Background thread publishing the registry
+ *
+ * Either rewrites a file at a fixed period (for node_exporter's textfile
+ * collector, say) or answers every connection to a port on 127.0.0.1 with
+ * the exposition as an HTTP response. Stops when destroyed.
+ */
+class MetricsExporter {
+private:
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+    int listener = -1;
+    std::thread worker;
+
+    void writeLoop(std::string path, std::chrono::milliseconds period);
+    void serveLoop();
+
+public:
+    /**
+     * @brief Rewrite a file periodically
+     * @param path File to write
+     * @param period Time between writes
+     * @throws std::runtime_error If the first write fails
+     */
+    MetricsExporter(const std::string &path,
+                    std::chrono::milliseconds period);
+
+    /**
+     * @brief Serve the exposition on a local TCP port
+     * @param port Port on 127.0.0.1
+     * @throws std::runtime_error If the port cannot be bound
+     */
+    explicit MetricsExporter(unsigned short port);
+
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter &) = delete;
+    MetricsExporter &operator=(const MetricsExporter &) = delete;
+};
@@ -0,0 +1,199 @@
+/**
+ * @file NativeSolver.hpp
+ * @brief Shared plumbing for the native (CPLEX-free) solver backends
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ *
+ * Native engines run in exact 64-bit integer arithmetic. Costs and balances
+ * are brought to integers by decimal scaling, solved, and scaled back when
+ * the Solution is assembled.
+ */
+
+#pragma once
+
+#include "Condensation.hpp"
+#include "FlowGraph.hpp"
+#include "NetworkFlow.hpp"
+#include "SolveArena.hpp"
+#include <string>
+#include <vector>
+
+/**
+ * @struct IntegralInstance
+ * @brief Network data scaled to 64-bit integers
+ *
+ * cost[a] = graph.cost[a] * costScale and supply[v] = balance(v + 1) *
+ * supplyScale, both exactly integral. The scales are powers of ten chosen
+ * as small as possible, and bounded so that path costs and flow totals
+ * cannot overflow.
+ *
+ * With a node order other than NodeOrder::Original the graph is renumbered
+ * and its arcs sorted by source; userNode() and userArc() translate back to
+ * the network's numbering.
+ */
+struct IntegralInstance {
+    FlowGraph graph;
+    Condensation condensation; ///< Strongly connected components of graph
+    std::vector<long long> cost;
+    std::vector<long long> supply;
+    std::vector<int> nodeId;   ///< Network node per node, empty if same
+    std::vector<size_t> arcId; ///< Network edge per arc, empty if same
+    double costScale;
+    double supplyScale;
+    long long totalSupply; ///< Sum of the positive scaled supplies
+    std::string error;     ///< Why scaling failed, empty on success
+
+    /**
+     * @brief Scale a network to integers
+     * @param net Source network
+     * @param threads Worker threads for building the graph
+     * @param order Node numbering of the graph
+     */
+    IntegralInstance(const NetworkFlow &net, unsigned threads,
+                     NodeOrder order = NodeOrder::Original);
+
+    /**
+     * @brief Network node of a graph node
+     * @param v Graph node (0-indexed)
+     * @return Network node (0-indexed)
+     */
+    int userNode(int v) const { return nodeId.empty() ? v : nodeId[v]; }
+
+    /**
+     * @brief Network edge of a graph arc
+     * @param a Graph arc
+     * @return Index of the edge in the network
+     */
+    size_t userArc(size_t a) const { return arcId.empty() ? a : arcId[a]; }
+
+    /**
+     * @brief Check whether the data could be scaled
+     * @return True if cost and supply hold valid integral data
+     */
+    bool ok() const { return error.empty(); }
+};
+
+/**
+ * @class NodeQueue
+ * @brief FIFO of distinct nodes for label-correcting loops
+ *
+ * Each node is queued at most once at a time, so a ring of n slots in the
+ * solve's arena replaces a std::deque that allocates and frees blocks as
+ * it moves.
+ */
+class NodeQueue {
+private:
+    ArenaVector<int> ring;
+    ArenaVector<char> queued;
+    size_t head;
+    size_t count;
+
+public:
+    /**
+     * @brief Create an empty queue
+     * @param n Number of nodes
+     * @param arena Arena holding the queue
+     */
+    NodeQueue(size_t n, SolveArena &arena)
+        : ring(arena.vector<int>(n)), queued(arena.vector<char>(n, 0)),
+          head(0), count(0) {}
+
+    bool empty() const { return count == 0; }
+
+    bool contains(int v) const { return queued[v] != 0; }
+
+    /**
+     * @brief Append a node unless it is already queued
+     * @param v Node
+     */
+    void push(int v) {
+        if (queued[v])
+            return;
+        queued[v] = 1;
+        size_t tail = head + count++;
+        ring[tail < ring.size() ? tail : tail - ring.size()] = v;
+    }
+
+    /**
+     * @brief Remove the oldest node
+     * @return Node removed
+     */
+    int pop() {
+        int v = ring[head];
+        queued[v] = 0;
+        head = head + 1 < ring.size() ? head + 1 : 0;
+        --count;
+        return v;
+    }
+
+    /**
+     * @brief Remove every queued node
+     */
+    void clear() {
+        while (count > 0)
+            pop();
+    }
+};
+
+/**
+ * @brief Initial arena size for the scratch data of a native engine
+ * @param inst Scaled instance
+ * @return Bytes for a handful of arrays per node and per arc
+ */
+size_t arenaBytes(const IntegralInstance &inst);
+
+/**
+ * @brief Check the preconditions shared by all native engines
+ * @param net Network being solved
+ * @param inst Scaled instance
+ * @param result Receives the status when a precondition fails
+ * @param threads Worker threads for the negative cycle search
+ * @return True if the engine may run
+ *
+ * Rejects data that could not be scaled, imbalanced networks (Infeasible)
+ * and networks with a negative cost cycle (Unbounded, since edges are
+ * uncapacitated, unless no feasible flow exists at all).
+ */
+bool nativePrecheck(const NetworkFlow &net, const IntegralInstance &inst,
+                    Solution &result, unsigned threads);
+
+/**
+ * @brief Route all supplies to the demands, ignoring costs
+ * @param inst Scaled instance
+ * @param flow Receives the scaled flow on each arc
+ * @return True if a feasible flow exists
+ */
+bool feasibleFlow(const IntegralInstance &inst, std::vector<long long> &flow);
+
+/**
+ * @brief Scale warm-start potentials into integer units
+ * @param options Solve options holding the potentials
+ * @param inst Scaled instance
+ * @return Integral potentials, all zero when none were supplied
+ * @throws std::invalid_argument If the number of potentials is wrong
+ */
+std::vector<long long> scaledPotentials(const SolveOptions &options,
+                                        const IntegralInstance &inst);
+
+/**
+ * @brief Scale a starting flow into integer units
+ * @param options Solve options holding the flow
+ * @param inst Scaled instance
+ * @return Integral flow on each arc, empty when none was supplied
+ * @throws std::invalid_argument If the flow has the wrong size, is negative
+ *         or does not satisfy flow conservation on the supply grid
+ */
+std::vector<long long> scaledFlows(const SolveOptions &options,
+                                   const IntegralInstance &inst);
+
+/**
+ * @brief Assemble an optimal Solution from integral engine results
+ * @param net Network that was solved
+ * @param inst Scaled instance
+ * @param flow Scaled flow on each arc
+ * @param potential Scaled node potentials (reduced cost c + pi_u - pi_v)
+ * @return Solution marked optimal, with flows and potentials unscaled
+ */
+Solution nativeSolution(const NetworkFlow &net, const IntegralInstance &inst,
+                        const std::vector<long long> &flow,
+                        const std::vector<long long> &potential);
@@ -10,10 +10,16 @@
 
 #pragma once
 
+#include "AllocationTracker.hpp"
+#include "Counters.hpp"
+#include "EdgeStore.hpp"
+#include <cstddef>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 /**
@@ -37,17 +43,41 @@ struct Edge {
     Edge(int f, int t, double c) : from(f), to(t), cost(c) {}
 };
 
+/// Basis of a solved network, see SimplexBasis.hpp
+class SimplexBasis;
+
 /**
  * @struct Solution
  * @brief Contains the solution results from the network flow optimization
  * 
  * Stores all relevant information about the optimization result including
- * feasibility status, optimal cost, and flow assignments.
+ * feasibility status, optimal cost, and flow assignments. Flows are available
+ * both per edge (edgeFlows, indexed like NetworkFlow::getEdges()) and as a
+ * map of the nonzero flows keyed by node pair.
+ *
+ * Node potentials pi (index node - 1) certify optimality: every edge has a
+ * reduced cost cost + pi[from] - pi[to] >= 0, with equality on edges that
+ * carry flow. They are empty if the backend does not provide them.
+ *
+ * The network simplex and CPLEX also return their optimal basis, which can
+ * be saved and passed back as SolveOptions::initialBasis.
+ *
+ * counters holds the pivots, pushes, heap operations and other algorithmic
+ * events of the solve (see Counters.hpp), all zero when counting is
+ * compiled out.
+ *
+ * allocations holds the heap and arena allocations of each phase of the
+ * solve while AllocationTracker is on, and is empty otherwise.
  */
 struct Solution {
     bool solved;
     double totalCost;
     std::map<std::pair<int, int>, double> flows;
+    std::vector<double> edgeFlows;
+    std::vector<double> potentials;
+    std::shared_ptr<const SimplexBasis> basis; ///< Null if not available
+    SolveCounters counters;
+    std::vector<PhaseAllocations> allocations;
     std::string status;
 
     /**
@@ -57,11 +87,211 @@ struct Solution {
     Solution() : solved(false), totalCost(0.0) {}
 };
 
+/**
+ * @enum SolverBackend
+ * @brief Algorithms available to NetworkFlow::solve()
+ */
+enum class SolverBackend {
+    Cplex,           ///< Linear program solved by IBM CPLEX
+    Relaxation,      ///< Native RELAX-IV style dual ascent
+    CapacityScaling, ///< Native capacity scaling shortest path augmentation
+    CycleCanceling,  ///< Native minimum mean cycle canceling from a flow
+    Transportation,  ///< Native shortest paths plus transportation problem
+    NetworkSimplex   ///< Native primal network simplex
+};
+
+/**
+ * @enum PricingRule
+ * @brief How the network simplex chooses its entering arc
+ */
+enum class PricingRule {
+    Block,        ///< Best arc of the next block of arcs with a candidate
+    CandidateList ///< Reprice a short list of candidates between full scans
+};
+
+/**
+ * @enum NodeOrder
+ * @brief Internal node numbering of the native backends
+ *
+ * Engines walk adjacency lists and index per-node arrays (balances,
+ * potentials, labels) by the neighbours they find. Numbering neighbouring
+ * nodes close together keeps those accesses in cache when the user's ids
+ * are arbitrary. Results are always reported in the user's numbering.
+ */
+enum class NodeOrder {
+    Original,            ///< Keep the user's node ids
+    ReverseCuthillMcKee, ///< Bandwidth-reducing breadth-first order, reversed
+    BreadthFirst,        ///< Breadth-first order from a peripheral node
+    DegreeSorted         ///< Hubs first, by decreasing degree
+};
+
+/// Shortest path tree cache, see ShortestPath.hpp
+class DistanceCache;
+/// Preprocessed topology for shortest path queries
+class ContractionHierarchy;
+
+/**
+ * @struct SolveOptions
+ * @brief Settings for NetworkFlow::solve()
+ */
+struct SolveOptions {
+    SolverBackend backend;
+    /**
+     * Warm-start node potentials (index node - 1), typically
+     * Solution::potentials of a previous solve with slightly different
+     * costs. Empty for a cold start; ignored by CPLEX.
+     */
+    std::vector<double> initialPotentials;
+    /**
+     * Starting flow per edge (indexed like NetworkFlow::getEdges()) for
+     * cycle canceling, e.g. from an upstream heuristic. It must be
+     * nonnegative and satisfy flow conservation. Empty to start from any
+     * feasible flow; ignored by the other backends.
+     */
+    std::vector<double> initialFlows;
+    /**
+     * Shortest path trees shared between solves by the transportation
+     * backend. Keep the same cache across solves that only change
+     * balances; it is cleared automatically when topology or costs change.
+     */
+    std::shared_ptr<DistanceCache> distanceCache;
+    /**
+     * Contraction hierarchy of the network's topology, used by the
+     * transportation backend instead of full shortest path trees. Ignored
+     * if it was built for another topology or gave up at its fill limit.
+     */
+    std::shared_ptr<const ContractionHierarchy> hierarchy;
+    /**
+     * Basis to start the network simplex or CPLEX from, typically
+     * Solution::basis of an earlier solve, possibly loaded from a file.
+     * Ignored if it was taken from another topology, or if it is not a
+     * spanning forest of this network.
+     */
+    std::shared_ptr<const SimplexBasis> initialBasis;
+    /**
+     * Node numbering the native backends work in; edges are then sorted
+     * by source. Ignored by CPLEX, and by the transportation backend when
+     * a hierarchy is given, since the hierarchy fixes its own numbering.
+     */
+    NodeOrder nodeOrder;
+    /**
+     * Let solve() take linear-time paths whatever backend is selected:
+     * networks that are forests when edge directions are ignored are
+     * solved in closed form, and acyclic networks with a single supply node
+     * go to the transportation backend, falling back to the selected
+     * backend if it finds no solution.
+     */
+    bool acyclicShortcut;
+    PricingRule pricing; ///< Entering arc rule of the network simplex
+    unsigned threads; ///< Worker threads, 0 for hardware concurrency
+
+    /**
+     * @brief Default constructor
+     * Selects CPLEX with a cold start on all hardware threads
+     */
+    SolveOptions()
+        : backend(SolverBackend::Cplex), nodeOrder(NodeOrder::Original),
+          acyclicShortcut(true), pricing(PricingRule::Block), threads(0) {}
+};
+
+/**
+ * @enum ValidationCode
+ * @brief Kinds of problems reported by NetworkFlow::validate()
+ */
+enum class ValidationCode {
+    Imbalanced,     ///< Total supply differs from total demand
+    InvalidEdge,    ///< Edge cost is not a finite number
+    IsolatedSupply, ///< Supply node without outgoing edges
+    IsolatedDemand, ///< Demand node without incoming edges
+    NegativeCycle,  ///< Cycle of negative total cost, the problem is unbounded
+    DuplicateArc,   ///< Another edge with the same endpoints precedes this one
+    ChecksSkipped   ///< Stored graph too large for the parallel edge and
+                    ///< negative cycle checks within the memory budget
+};
+
+/**
+ * @enum ValidationSeverity
+ * @brief Whether an issue prevents solving the network
+ */
+enum class ValidationSeverity {
+    Error,  ///< The problem cannot be solved as given
+    Warning ///< Legal input that may be unintended, e.g. parallel edges
+};
+
+/**
+ * @struct ValidationIssue
+ * @brief A single problem found in the network
+ */
+struct ValidationIssue {
+    ValidationCode code;
+    int node;            ///< Offending node (1-indexed), 0 if not applicable
+    long long edge;      ///< Offending edge index, -1 if not applicable
+    double amount;       ///< Imbalance or cycle cost, 0 if not applicable
+    std::string message; ///< Human readable description
+
+    ValidationIssue(ValidationCode c, int n, long long e, double a,
+                    std::string msg)
+        : code(c), node(n), edge(e), amount(a), message(std::move(msg)) {}
+
+    /**
+     * @brief Severity of the issue
+     * @return Warning for duplicate arcs and skipped checks, Error for
+     *         every other code
+     */
+    ValidationSeverity severity() const {
+        return code == ValidationCode::DuplicateArc ||
+                       code == ValidationCode::ChecksSkipped
+                   ? ValidationSeverity::Warning
+                   : ValidationSeverity::Error;
+    }
+};
+
+/**
+ * @struct ValidationReport
+ * @brief Every problem found in the network by a single validation run
+ *
+ * Issues are ordered by code, then by node or edge index.
+ */
+struct ValidationReport {
+    std::vector<ValidationIssue> issues;
+    double imbalance; ///< Sum of all balances (0 for a balanced network)
+
+    /**
+     * @brief Default constructor
+     * Initializes an empty report of a balanced network
+     */
+    ValidationReport() : imbalance(0.0) {}
+
+    /**
+     * @brief Check whether the network passed validation
+     * @return True if no issue is an error; warnings are allowed
+     */
+    bool valid() const;
+
+    /**
+     * @brief Count issues of one kind
+     * @param code Issue kind
+     * @return Number of issues with that code
+     */
+    size_t count(ValidationCode code) const;
+
+    /**
+     * @brief Describe the report in text
+     * @param maxIssues Maximum number of issues listed individually
+     * @return "valid", or one line per issue followed by a count of the rest
+     */
+    std::string summary(size_t maxIssues = 10) const;
+};
+
 /**
  * @class NetworkFlow
  * @brief Main class for modeling and solving minimum cost network flow problems
  * 
  * The network uses 1-indexed node numbering for user convenience.
+ *
+ * Edges live either in memory, added with addEdge(), or in an EdgeStore
+ * file for networks that do not fit in RAM. Code that must handle both
+ * reads edges with sweepEdges(); getEdges() is only for in-memory networks.
  * 
  * @example
  * ```cpp
@@ -71,7 +301,7 @@ struct Solution {
  * net.addEdge(1, 2, 5);    Edge from 1 to 2 with cost 5
  * net.addEdge(2, 4, 3);    Edge from 2 to 4 with cost 3
  *
- * if (net.validate() == "valid") {
+ * if (net.validate().valid()) {
  *     Solution sol = net.solve();
  *     if (sol.solved) {
  *         std::cout << "Minimum cost: " << sol.totalCost << std::endl;
@@ -84,6 +314,12 @@ private:
     int numNodes;
     std::vector<double> balances;
     std::vector<Edge> edges;
+    std::shared_ptr<const EdgeStore> store;
+
+    Solution solveWithBackend(const SolveOptions &options,
+                              const char *&backend) const;
+    Solution solveWithCplex(const SimplexBasis *initialBasis) const;
+    void requireInMemory(const char *operation) const;
 
 public:
     /**
@@ -92,6 +328,15 @@ public:
      */
     explicit NetworkFlow(int n);
 
+    /**
+     * @brief Construct a network whose edges live in an edge store
+     * @param n Number of nodes in the network (1-indexed)
+     * @param edgeStore Edges of the network; edges cannot be added later
+     * @throws std::out_of_range If an edge of the store uses a node
+     *         outside [1, n]
+     */
+    NetworkFlow(int n, std::shared_ptr<const EdgeStore> edgeStore);
+
     /**
      * @brief Get the number of nodes in the network
      * @return Number of nodes
@@ -105,12 +350,36 @@ public:
      */
     double getBalance(int node) const;
 
+    /**
+     * @brief Get the number of edges in the network
+     * @return Number of edges
+     */
+    size_t getNumEdges() const;
+
     /**
      * @brief Get read-only access to all edges
      * @return Const reference to vector of Edge objects
+     * @throws std::logic_error If the edges live in an edge store
      */
     const std::vector<Edge> &getEdges() const;
 
+    /**
+     * @brief Get the edge store holding the edges
+     * @return Store, or null for an in-memory network
+     */
+    const std::shared_ptr<const EdgeStore> &getEdgeStore() const;
+
+    /**
+     * @brief Visit all edges in blocks of consecutive edges
+     * @param fn Callback receiving each block once
+     * @param threads Worker threads, 0 for hardware concurrency; with 1
+     *        thread blocks arrive in edge order on the calling thread
+     *
+     * Works for in-memory and stored edges alike. Stored edges are read
+     * within the store's memory budget.
+     */
+    void sweepEdges(const EdgeSweep &fn, unsigned threads = 1) const;
+
     /**
      * @brief Set the supply/demand balance for a node
      * @param node Node index (1-indexed)
@@ -125,24 +394,63 @@ public:
      * @param to Destination node index (1-indexed)
      * @param cost Cost per unit of flow on this edge
      * @throws std::out_of_range If node indices are invalid
+     * @throws std::logic_error If the edges live in an edge store
      */
     void addEdge(int from, int to, double cost);
 
     /**
-     * @brief Solve the minimum cost network flow problem
+     * @brief Append a batch of directed edges stored as parallel arrays
+     * @param from Source node indices (1-indexed)
+     * @param to Destination node indices (1-indexed)
+     * @param cost Costs per unit of flow
+     * @param count Number of edges in the arrays
+     * @throws std::out_of_range If any node index is invalid; no edge of the
+     *         batch is added in that case
+     * @throws std::logic_error If the edges live in an edge store
+     */
+    void addEdges(const int *from, const int *to, const double *cost,
+                  size_t count);
+
+    /**
+     * @brief Reserve storage for a total number of edges
+     * @param count Expected number of edges
+     * @throws std::logic_error If the edges live in an edge store
+     */
+    void reserveEdges(size_t count);
+
+    /**
+     * @brief Solve the minimum cost network flow problem with CPLEX
      * @return Solution object with results and status
      */
     Solution solve() const;
 
+    /**
+     * @brief Solve the minimum cost network flow problem
+     * @param options Backend selection and warm-start data
+     * @return Solution object with results and status
+     *
+     * Backends keep the graph in memory, so stored edges whose graph does
+     * not fit the store's memory budget get a "Memory budget exceeded"
+     * status without solving.
+     */
+    Solution solve(const SolveOptions &options) const;
+
     /**
      * @brief Check if supply and demand are balanced
      * @return True if total supply equals total demand
      */
     bool isBalanced() const;
 
+    /**
+     * @brief Get the net balance of the network
+     * @return Sum of all node balances (zero for a balanced network)
+     */
+    double getImbalance() const;
+
     /**
      * @brief Validate the complete network configuration
-     * @return "valid" if network is properly configured, error message otherwise
+     * @param threads Worker threads, 0 for hardware concurrency
+     * @return Report listing every problem found
      */
-    std::string validate() const;
+    ValidationReport validate(unsigned threads = 0) const;
 };
\ No newline at end of file
@@ -0,0 +1,52 @@
+/**
+ * @file NetworkSimplexSolver.hpp
+ * @brief Native primal network simplex solver
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ */
+
+#pragma once
+
+#include "NetworkFlow.hpp"
+
+/**
+ * @class NetworkSimplexSolver
+ * @brief Minimum cost flow by the primal network simplex method
+ *
+ * The basis is a spanning tree rooted at an artificial node that every
+ * node is joined to by an artificial arc of prohibitive cost; the initial
+ * tree ships every supply through the root. Each pivot
+ * - prices the arcs to find one with negative reduced cost
+ *   c[a] + pi[u] - pi[v] (SolveOptions::pricing selects block or
+ *   candidate list pricing, both running on the vectorized kernels of
+ *   Pricing.hpp),
+ * - pushes flow around the cycle the arc closes in the tree until a tree
+ *   arc empties, chosen so that the tree stays strongly feasible and the
+ *   method cannot cycle,
+ * - swaps the two arcs and shifts the potentials of the subtree that
+ *   moved.
+ *
+ * Flow left on an artificial arc at the end proves infeasibility. All
+ * arithmetic is on integers after decimal scaling. The final tree is
+ * returned as Solution::basis, and a later solve can start from it
+ * through SolveOptions::initialBasis.
+ */
+class NetworkSimplexSolver {
+private:
+    const NetworkFlow &net;
+
+public:
+    /**
+     * @brief Construct a solver for a network
+     * @param network Network to solve, must outlive the solver
+     */
+    explicit NetworkSimplexSolver(const NetworkFlow &network);
+
+    /**
+     * @brief Solve the network
+     * @param options Solve options (threads, pricing rule, node order,
+     *        starting basis)
+     * @return Solution with flows, optimal potentials and the optimal basis
+     */
+    Solution solve(const SolveOptions &options) const;
+};
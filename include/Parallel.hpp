@@ -0,0 +1,290 @@
+/**
+ * @file Parallel.hpp
+ * @brief Small helpers for running work on all hardware threads
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ *
+ * Header-only helpers built on std::thread. Work is expressed as a number of
+ * independent tasks that worker threads claim through an atomic counter, so
+ * uneven tasks are balanced without a central scheduler. Loops that need a
+ * parallel step many times per second use a WorkerPool instead, which keeps
+ * its threads between steps.
+ *
+ * Events and allocations counted by worker threads (see Counters.hpp and
+ * AllocationTracker.hpp) are added to the scopes of the thread that
+ * started the work once it is done, and worker threads charge their
+ * allocations to that thread's phase.
+ */
+
+#pragma once
+
+#include "AllocationTracker.hpp"
+#include "Counters.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Number of worker threads to use
+ * @param requested Requested thread count, 0 selects the hardware concurrency
+ * @return Thread count, at least 1
+ */
+inline unsigned workerCount(unsigned requested = 0) {
+    if (requested > 0)
+        return requested;
+    unsigned hw = std::thread::hardware_concurrency();
+    return hw > 0 ? hw : 1;
+}
+
+/**
+ * @brief Run fn(task) for every task in [0, numTasks) on up to threads threads
+ * @param numTasks Number of tasks
+ * @param threads Maximum number of threads, 0 for hardware concurrency
+ * @param fn Callable taking the task index
+ * @throws Rethrows the first exception raised by any task
+ *
+ * With a single task or a single thread the tasks run on the calling thread.
+ */
+template <typename F>
+void parallelTasks(size_t numTasks, unsigned threads, F &&fn) {
+    unsigned count = static_cast<unsigned>(
+        std::min<size_t>(workerCount(threads), numTasks));
+    if (count <= 1) {
+        for (size_t t = 0; t < numTasks; ++t)
+            fn(t);
+        return;
+    }
+
+    std::atomic<size_t> next(0);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+
+    auto worker = [&]() {
+        TraceScope trace("worker", "worker");
+        try {
+            for (size_t t = next++; t < numTasks; t = next++)
+                fn(t);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error)
+                error = std::current_exception();
+            next = numTasks;
+        }
+    };
+
+    // Other threads count into their own slots, merged after the join
+    std::vector<SolveCounters> counted(EventCounters::current() ? count : 0);
+    std::vector<AllocationTracker::Totals> allocated(
+        AllocationTracker::enabled() && AllocationTracker::scope() ? count
+                                                                   : 0);
+    const int phase = AllocationTracker::phase();
+    std::vector<std::thread> pool;
+    pool.reserve(count - 1);
+    for (unsigned i = 1; i < count; ++i)
+        pool.emplace_back([&, i]() {
+            AllocationTracker::adopt(phase);
+            if (!allocated.empty())
+                AllocationTracker::redirect(&allocated[i]);
+            if (!counted.empty())
+                EventCounters::redirect(&counted[i]);
+            worker();
+        });
+    worker();
+    for (auto &t : pool)
+        t.join();
+    for (const SolveCounters &counts : counted)
+        EventCounters::merge(counts);
+    for (const AllocationTracker::Totals &counts : allocated)
+        AllocationTracker::merge(counts);
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+/**
+ * @brief Split [0, n) into contiguous chunks and run fn(chunk, begin, end)
+ * @param n Size of the index range
+ * @param minChunk Smallest chunk worth handing to a thread
+ * @param threads Maximum number of threads, 0 for hardware concurrency
+ * @param fn Callable taking the chunk index and its half-open range
+ * @return Number of chunks the range was split into
+ */
+template <typename F>
+size_t parallelChunks(size_t n, size_t minChunk, unsigned threads, F &&fn) {
+    size_t chunks = std::min<size_t>(workerCount(threads),
+                                     n / std::max<size_t>(minChunk, 1));
+    chunks = std::max<size_t>(chunks, 1);
+    size_t step = (n + chunks - 1) / chunks;
+    parallelTasks(chunks, threads, [&](size_t c) {
+        size_t begin = std::min(n, c * step);
+        size_t end = std::min(n, begin + step);
+        fn(c, begin, end);
+    });
+    return chunks;
+}
+
+/**
+ * @class WorkerPool
+ * @brief Threads kept alive to run many short parallel steps
+ *
+ * Starting threads costs tens of microseconds, more than a short step is
+ * worth. The pool's threads wait between steps, first spinning briefly and
+ * then sleeping, so a step costs about a cache line transfer when the steps
+ * come in quick succession. The calling thread takes part as worker 0.
+ */
+class WorkerPool {
+private:
+    /// Polls of the step counter before a waiting thread goes to sleep
+    static constexpr unsigned SPIN_ROUNDS = 1 << 12;
+
+    std::vector<std::thread> pool;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    std::atomic<unsigned long> step{0};
+    std::atomic<unsigned> pending{0};
+    bool stopping = false;
+    void (*task)(void *, unsigned) = nullptr;
+    void *context = nullptr;
+    std::exception_ptr error;
+    std::vector<SolveCounters> counted; ///< Events of each worker's step
+    std::vector<AllocationTracker::Totals> allocated; ///< Same for memory
+    int phase = 0; ///< Allocation phase of the caller
+
+    template <typename Ready> static bool spin(Ready &&ready) {
+        for (unsigned i = 0; i < SPIN_ROUNDS; ++i) {
+            if (ready())
+                return true;
+            std::this_thread::yield();
+        }
+        return false;
+    }
+
+    void fail() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error)
+            error = std::current_exception();
+    }
+
+    void loop(unsigned id) {
+        EventCounters::redirect(&counted[id]);
+        AllocationTracker::redirect(&allocated[id]);
+        unsigned long seen = 0;
+        while (true) {
+            auto moved = [&]() {
+                return step.load(std::memory_order_acquire) != seen;
+            };
+            if (!spin(moved)) {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, moved);
+            }
+            seen = step.load(std::memory_order_acquire);
+            if (stopping)
+                return;
+            AllocationTracker::adopt(phase);
+            try {
+                task(context, id);
+            } catch (...) {
+                fail();
+            }
+            if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard<std::mutex> lock(mutex);
+                finished.notify_one();
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Start the pool
+     * @param threads Number of workers including the caller, 0 for hardware
+     *        concurrency
+     */
+    explicit WorkerPool(unsigned threads) {
+        unsigned count = workerCount(threads);
+        counted.resize(count);
+        allocated.resize(count);
+        pool.reserve(count - 1);
+        for (unsigned id = 1; id < count; ++id)
+            pool.emplace_back([this, id]() { loop(id); });
+    }
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+            step.fetch_add(1, std::memory_order_release);
+        }
+        wake.notify_all();
+        for (auto &t : pool)
+            t.join();
+    }
+
+    /**
+     * @brief Number of workers, the caller included
+     * @return Worker count, at least 1
+     */
+    unsigned size() const { return static_cast<unsigned>(pool.size()) + 1; }
+
+    /**
+     * @brief Run fn(worker) once on every worker and wait for all of them
+     * @param fn Callable taking the worker index in [0, size())
+     * @throws Rethrows the first exception raised by any worker
+     */
+    template <typename F> void run(F &&fn) {
+        if (pool.empty()) {
+            fn(0u);
+            return;
+        }
+
+        using Fn = std::remove_reference_t<F>;
+        task = [](void *ctx, unsigned id) { (*static_cast<Fn *>(ctx))(id); };
+        context = const_cast<void *>(static_cast<const void *>(&fn));
+        phase = AllocationTracker::phase();
+        pending.store(static_cast<unsigned>(pool.size()),
+                      std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            step.fetch_add(1, std::memory_order_release);
+        }
+        wake.notify_all();
+
+        try {
+            fn(0u);
+        } catch (...) {
+            fail();
+        }
+        auto idle = [&]() {
+            return pending.load(std::memory_order_acquire) == 0;
+        };
+        if (!spin(idle)) {
+            std::unique_lock<std::mutex> lock(mutex);
+            finished.wait(lock, idle);
+        }
+        for (unsigned id = 1; id < size(); ++id) {
+            EventCounters::merge(counted[id]);
+            counted[id] = SolveCounters();
+        }
+        if (AllocationTracker::enabled())
+            for (unsigned id = 1; id < size(); ++id) {
+                AllocationTracker::merge(allocated[id]);
+                allocated[id] = AllocationTracker::Totals();
+            }
+
+        if (error) {
+            std::exception_ptr raised = error;
+            error = nullptr;
+            std::rethrow_exception(raised);
+        }
+    }
+};
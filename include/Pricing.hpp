@@ -0,0 +1,73 @@
+/**
+ * @file Pricing.hpp
+ * @brief Vectorized reduced cost kernels for network simplex pricing
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ *
+ * Pricing computes c[a] + pi[source[a]] - pi[target[a]] over many arcs and
+ * keeps the most negative one. The potentials are indexed through the arc
+ * endpoints, so the kernels load them with gather instructions: eight arcs
+ * per step with AVX-512, four with AVX2. The instruction set is chosen once
+ * at run time from the CPU's features, and a scalar loop serves other CPUs
+ * and compilers. Every variant returns the same result.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @struct PricingArcs
+ * @brief Structure-of-arrays view of the arcs and potentials to price
+ */
+struct PricingArcs {
+    const int *source;     ///< Tail per arc
+    const int *target;     ///< Head per arc
+    const long long *cost; ///< Cost per arc
+    const long long *pi;   ///< Potential per node
+};
+
+/**
+ * @struct ArcPrice
+ * @brief Best candidate found by a pricing kernel
+ */
+struct ArcPrice {
+    long long reduced; ///< Reduced cost of arc, 0 if none is negative
+    size_t arc;        ///< Arc with the most negative reduced cost, or NO_ARC
+};
+
+/**
+ * @brief Find the arc with the most negative reduced cost in a range
+ * @param arcs Arcs and potentials
+ * @param begin First arc
+ * @param end One past the last arc
+ * @return Most negative reduced cost and its arc (the lowest index on ties),
+ *         or {0, NO_ARC} if no reduced cost in the range is negative
+ */
+ArcPrice priceRange(const PricingArcs &arcs, size_t begin, size_t end);
+
+/**
+ * @brief Reduced costs of a range of arcs
+ * @param arcs Arcs and potentials
+ * @param begin First arc
+ * @param end One past the last arc
+ * @param out Receives end - begin reduced costs
+ */
+void rangeReducedCosts(const PricingArcs &arcs, size_t begin, size_t end,
+                       long long *out);
+
+/**
+ * @brief Reduced costs of listed arcs
+ * @param arcs Arcs and potentials
+ * @param list Arc indices
+ * @param count Number of listed arcs
+ * @param out Receives count reduced costs
+ */
+void listReducedCosts(const PricingArcs &arcs, const size_t *list,
+                      size_t count, long long *out);
+
+/**
+ * @brief Instruction set the kernels run with on this CPU
+ * @return "avx512f", "avx2" or "scalar"
+ */
+const char *pricingInstructionSet();
@@ -0,0 +1,46 @@
+/**
+ * @file RelaxationSolver.hpp
+ * @brief Native dual ascent solver in the style of Bertsekas' RELAX-IV
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ */
+
+#pragma once
+
+#include "NetworkFlow.hpp"
+
+/**
+ * @class RelaxationSolver
+ * @brief Minimum cost flow by the relaxation (dual coordinate ascent) method
+ *
+ * The solver keeps a flow and node potentials that satisfy complementary
+ * slackness at all times and works towards primal feasibility:
+ * - an auction-style initialization lets every node with surplus bid for its
+ *   cheapest residual arcs, raising its price and pushing flow along them,
+ * - relaxation iterations then grow a set S of nodes from a surplus node
+ *   along balanced (zero reduced cost) arcs. As soon as raising the prices
+ *   of S improves the dual, the prices are raised; if a deficit node is
+ *   reached first, flow is augmented along the labeled path.
+ *
+ * All arithmetic is done on integers after decimal scaling, so the method
+ * terminates exactly. Warm-start potentials from a previous solve keep most
+ * arcs balanced when costs change slightly, which leaves little work.
+ */
+class RelaxationSolver {
+private:
+    const NetworkFlow &net;
+
+public:
+    /**
+     * @brief Construct a solver for a network
+     * @param network Network to solve, must outlive the solver
+     */
+    explicit RelaxationSolver(const NetworkFlow &network);
+
+    /**
+     * @brief Solve the network
+     * @param options Solve options (threads, warm-start potentials)
+     * @return Solution with flows and optimal potentials
+     */
+    Solution solve(const SolveOptions &options) const;
+};
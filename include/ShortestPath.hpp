@@ -0,0 +1,289 @@
+/**
+ * @file ShortestPath.hpp
+ * @brief Parallel single-source shortest path kernels over FlowGraph
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ *
+ * Potential initialization, negative cycle detection and shortest path
+ * based engines share these kernels. They are templates over the cost type
+ * and instantiated for double (FlowGraph::cost) and long long (scaled
+ * integer costs of the native engines). Arc costs are passed separately so
+ * callers can run them on reduced or scaled costs of the same topology.
+ */
+
+#pragma once
+
+#include "Condensation.hpp"
+#include "FlowGraph.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/// Predecessor of nodes without an incoming tree arc
+constexpr size_t NO_ARC = std::numeric_limits<size_t>::max();
+
+/**
+ * @brief Distance of nodes not reached by a search
+ * @return Infinity for floating point costs, the largest value otherwise
+ */
+template <typename Cost> constexpr Cost unreachableDistance() {
+    return std::numeric_limits<Cost>::has_infinity
+               ? std::numeric_limits<Cost>::infinity()
+               : std::numeric_limits<Cost>::max();
+}
+
+/**
+ * @struct ShortestPathTree
+ * @brief Result of a shortest path search
+ */
+template <typename Cost> struct ShortestPathTree {
+    std::vector<Cost> dist;   ///< Label per node, or unreachableDistance()
+    std::vector<size_t> pred; ///< Tree arc into each node, NO_ARC at roots
+    std::vector<size_t> negativeCycle; ///< Negative cycle found, if any
+};
+
+/// Smallest graph whose single-source searches run on deltaStepping()
+constexpr size_t PARALLEL_SEARCH_NODES = size_t(1) << 12;
+
+/**
+ * @brief Parallel delta-stepping for nonnegative costs
+ * @param g Graph topology
+ * @param cost Nonnegative cost per arc
+ * @param sources Start nodes, all at distance zero
+ * @param threads Worker threads, 0 for hardware concurrency
+ * @param delta Bucket width, 0 to derive it from the costs
+ * @return Distances and shortest path tree
+ *
+ * Nodes are settled bucket by bucket. Within a bucket, arcs no longer than
+ * delta are relaxed in parallel rounds until the bucket is empty, then the
+ * longer arcs are relaxed once. Relaxation requests are generated per
+ * thread and applied by the owner of the target node, so no atomics are
+ * needed on the distances.
+ *
+ * Pays off on graphs of PARALLEL_SEARCH_NODES and more; below that, the
+ * serial searches are faster.
+ */
+template <typename Cost>
+ShortestPathTree<Cost> deltaStepping(const FlowGraph &g,
+                                     const std::vector<Cost> &cost,
+                                     const std::vector<int> &sources,
+                                     unsigned threads = 0, Cost delta = 0);
+
+/**
+ * @brief Parallel frontier-based Bellman-Ford for arbitrary costs
+ * @param g Graph topology
+ * @param cost Cost per arc
+ * @param initial Starting label per node, unreachableDistance() for none
+ * @param threads Worker threads, 0 for hardware concurrency
+ * @return Distances and shortest path tree, or a negative cycle
+ *
+ * Each round, the nodes whose label dropped in the previous round form the
+ * frontier; every node with an arc from the frontier pulls its best new
+ * label over its incoming arcs. Rounds only read the previous labels, so
+ * nodes are processed in parallel without synchronization. A cycle in the
+ * predecessor graph, checked after every n label changes, proves a
+ * negative cycle; dist and pred are then incomplete.
+ *
+ * Starting with every label at zero finds potentials for all nodes (a
+ * virtual source); starting from previous potentials only corrects the
+ * labels that cost changes invalidated.
+ */
+template <typename Cost>
+ShortestPathTree<Cost> bellmanFord(const FlowGraph &g,
+                                   const std::vector<Cost> &cost,
+                                   std::vector<Cost> initial,
+                                   unsigned threads = 0);
+
+/// Largest component condensedBellmanFord() handles on one thread
+constexpr size_t SERIAL_COMPONENT_NODES = size_t(1) << 14;
+
+/**
+ * @brief Bellman-Ford that follows the condensation of the graph
+ * @param g Graph topology
+ * @param cond Strongly connected components of g
+ * @param cost Cost per arc
+ * @param initial Starting label per node, unreachableDistance() for none
+ * @param threads Worker threads, 0 for hardware concurrency
+ * @return Same result as bellmanFord()
+ *
+ * Visits the components in topological order. Each node first pulls its
+ * label over the arcs from earlier components, which are final by then;
+ * a component with inner arcs is then settled by a FIFO label-correcting
+ * loop over those arcs alone, checking its own predecessors for a cycle
+ * after every size-many label changes. On acyclic graphs this is a single
+ * linear pass. When one component exceeds SERIAL_COMPONENT_NODES and
+ * several threads are allowed, the parallel bellmanFord() runs instead.
+ */
+template <typename Cost>
+ShortestPathTree<Cost> condensedBellmanFord(const FlowGraph &g,
+                                            const Condensation &cond,
+                                            const std::vector<Cost> &cost,
+                                            std::vector<Cost> initial,
+                                            unsigned threads = 0);
+
+/// Sources handled together by multiSourceDistances()
+constexpr size_t MULTI_SOURCE_WIDTH = 8;
+
+/**
+ * @brief Shortest paths from a batch of sources at once
+ * @param g Graph topology
+ * @param cost Nonnegative cost per arc
+ * @param sources Up to MULTI_SOURCE_WIDTH start nodes
+ * @param dist Receives MULTI_SOURCE_WIDTH labels per node, interleaved:
+ *        dist[v * MULTI_SOURCE_WIDTH + j] belongs to sources[j]
+ * @param pred Receives the tree arcs in the same layout
+ *
+ * Label-correcting search that scans nodes in order of their smallest
+ * label that dropped, so with one source it is Dijkstra's algorithm.
+ * Relaxing an arc updates all labels of its head in one loop over
+ * contiguous memory, which the compiler turns into SIMD min operations, so
+ * the subgraph shared by the sources is scanned once per batch instead of
+ * once per source. Unused lanes and unreached nodes keep
+ * unreachableDistance<long long>().
+ */
+void multiSourceDistances(const FlowGraph &g,
+                          const std::vector<long long> &cost,
+                          const std::vector<int> &sources,
+                          std::vector<long long> &dist,
+                          std::vector<size_t> &pred);
+
+/**
+ * @brief Shortest paths from a batch of sources in an acyclic graph
+ * @param g Graph topology without directed cycles
+ * @param cond Components of g, all single nodes (Condensation::acyclic())
+ * @param cost Cost per arc, negative costs allowed
+ * @param sources Up to MULTI_SOURCE_WIDTH start nodes
+ * @param dist Receives labels in the layout of multiSourceDistances()
+ * @param pred Receives the tree arcs in the same layout
+ *
+ * Dynamic programming in topological order: each node pulls its labels
+ * over its incoming arcs once, all lanes in one loop, so a batch costs a
+ * single linear pass without a heap.
+ */
+void acyclicDistances(const FlowGraph &g, const Condensation &cond,
+                      const std::vector<long long> &cost,
+                      const std::vector<int> &sources,
+                      std::vector<long long> &dist,
+                      std::vector<size_t> &pred);
+
+/**
+ * @brief Fingerprint of a topology with integer costs
+ * @param g Graph topology
+ * @param cost Cost per arc
+ * @return 64-bit FNV-1a hash of the node count, arcs and costs
+ */
+uint64_t graphFingerprint(const FlowGraph &g,
+                          const std::vector<long long> &cost);
+
+/**
+ * @class DistanceCache
+ * @brief Shortest path trees kept between solves
+ *
+ * Holds one tree per source node, valid for a single graph fingerprint.
+ * Passing the same cache to consecutive solves whose costs and topology
+ * stay the same (only balances change) skips the shortest path searches of
+ * every source seen before. Trees are added until the memory budget is
+ * used up. Lookups and insertions may come from several threads.
+ */
+class DistanceCache {
+private:
+    size_t maxBytes;
+    size_t usedBytes;
+    uint64_t fingerprint;
+    std::unordered_map<int, ShortestPathTree<long long>> trees;
+    mutable std::mutex mutex;
+
+public:
+    /**
+     * @brief Create an empty cache
+     * @param budget Largest number of bytes of trees to keep
+     */
+    explicit DistanceCache(size_t budget = size_t(1) << 30);
+
+    /**
+     * @brief Prepare the cache for a graph
+     * @param graph Fingerprint of the graph about to be searched
+     *
+     * Drops all trees if they were computed for a different graph. Must not
+     * run concurrently with other calls.
+     */
+    void bind(uint64_t graph);
+
+    /**
+     * @brief Look up the tree of a source
+     * @param source Source node (0-indexed)
+     * @return Cached tree, or nullptr; stays valid until bind() or clear()
+     */
+    const ShortestPathTree<long long> *find(int source) const;
+
+    /**
+     * @brief Store the tree of a source
+     * @param source Source node (0-indexed)
+     * @param tree Tree to keep
+     * @return False if the budget is exhausted and the tree was dropped
+     */
+    bool insert(int source, ShortestPathTree<long long> tree);
+
+    /**
+     * @brief Drop all trees
+     */
+    void clear();
+
+    /**
+     * @brief Number of cached trees
+     * @return Tree count
+     */
+    size_t size() const;
+};
+
+/**
+ * @brief Find a cycle of negative total cost
+ * @param g Graph to search, using FlowGraph::cost
+ * @param threads Worker threads, 0 for hardware concurrency
+ * @return Arc indices of one negative cycle in traversal order, or an empty
+ *         vector if every cycle has nonnegative cost
+ *
+ * Computes the strongly connected components and searches inside them.
+ * Returns immediately when no arc has negative cost.
+ */
+std::vector<size_t> findNegativeCycle(const FlowGraph &g,
+                                      unsigned threads = 0);
+
+/**
+ * @brief Find a cycle of negative total cost inside components
+ * @param g Graph to search, using FlowGraph::cost
+ * @param cond Strongly connected components of g
+ * @param threads Worker threads, 0 for hardware concurrency
+ * @return Arc indices of one negative cycle in traversal order, or an empty
+ *         vector if every cycle has nonnegative cost
+ *
+ * Arcs between components lie on no cycle, so only the arcs inside
+ * components are searched, and only if one of them is negative.
+ */
+std::vector<size_t> findNegativeCycle(const FlowGraph &g,
+                                      const Condensation &cond,
+                                      unsigned threads = 0);
+
+extern template ShortestPathTree<double>
+deltaStepping(const FlowGraph &, const std::vector<double> &,
+              const std::vector<int> &, unsigned, double);
+extern template ShortestPathTree<long long>
+deltaStepping(const FlowGraph &, const std::vector<long long> &,
+              const std::vector<int> &, unsigned, long long);
+extern template ShortestPathTree<double>
+bellmanFord(const FlowGraph &, const std::vector<double> &,
+            std::vector<double>, unsigned);
+extern template ShortestPathTree<long long>
+bellmanFord(const FlowGraph &, const std::vector<long long> &,
+            std::vector<long long>, unsigned);
+extern template ShortestPathTree<double>
+condensedBellmanFord(const FlowGraph &, const Condensation &,
+                     const std::vector<double> &, std::vector<double>,
+                     unsigned);
+extern template ShortestPathTree<long long>
+condensedBellmanFord(const FlowGraph &, const Condensation &,
+                     const std::vector<long long> &, std::vector<long long>,
+                     unsigned);
@@ -0,0 +1,89 @@
+/**
+ * @file SimplexBasis.hpp
+ * @brief Optimal basis kept between solves and process restarts
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ *
+ * A basis of the minimum cost flow LP is a spanning forest of the network:
+ * its basic edges, plus one root node per tree whose conservation row
+ * (the artificial arc of the network simplex) is basic. The network
+ * simplex and CPLEX both export their final basis in this form and can
+ * start from one, which saves most pivots when only costs or balances
+ * changed. The basis is saved together with the topology hash of the
+ * network it belongs to, so a stale file is detected instead of used.
+ */
+
+#pragma once
+
+#include "NetworkFlow.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class SimplexBasis
+ * @brief Basic edges and root nodes of a solved network
+ *
+ * Edges are indexed like NetworkFlow::getEdges() and nodes 0-indexed.
+ * There are as many basic edges and root nodes together as the network has
+ * nodes. Whether they really form a spanning forest is checked by the
+ * solver that starts from the basis, which falls back to a cold start
+ * otherwise.
+ */
+class SimplexBasis {
+private:
+    uint64_t hash;
+    int numNodes;
+    size_t numEdges;
+    std::vector<size_t> basicEdges;
+    std::vector<int> roots;
+
+    SimplexBasis();
+
+public:
+    /**
+     * @brief Describe a basis of a network
+     * @param net Network the basis belongs to
+     * @param edges Basic edges
+     * @param rootNodes Nodes whose conservation row is basic (0-indexed)
+     * @throws std::invalid_argument If an index is out of range or repeated,
+     *         or the counts do not add up to the number of nodes
+     */
+    SimplexBasis(const NetworkFlow &net, std::vector<size_t> edges,
+                 std::vector<int> rootNodes);
+
+    /**
+     * @brief Read a basis written by save()
+     * @param path File to read
+     * @return Basis stored in the file
+     * @throws std::runtime_error If the file cannot be read or is invalid
+     */
+    static SimplexBasis load(const std::string &path);
+
+    /**
+     * @brief Write the basis to a binary file
+     * @param path File to write
+     * @throws std::runtime_error If the file cannot be written
+     */
+    void save(const std::string &path) const;
+
+    /**
+     * @brief Check whether the basis was taken from a network's topology
+     * @param net Network to check
+     * @return True if node count, edge count and topology hash match
+     */
+    bool matches(const NetworkFlow &net) const;
+
+    /**
+     * @brief Basic edges
+     * @return Edge indices in increasing order
+     */
+    const std::vector<size_t> &edges() const { return basicEdges; }
+
+    /**
+     * @brief Nodes whose conservation row is basic
+     * @return 0-indexed nodes in increasing order
+     */
+    const std::vector<int> &rootNodes() const { return roots; }
+};
@@ -0,0 +1,167 @@
+/**
+ * @file SolutionWriter.hpp
+ * @brief Buffered exporters for network flow solutions
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ *
+ * This file defines writers that stream a Solution to CSV, JSON or a
+ * columnar binary format. All writers format numbers with std::to_chars and
+ * hand large blocks to the C stdio layer, so exporting very large solutions
+ * is limited by the disk rather than by number formatting.
+ */
+
+#pragma once
+
+#include "NetworkFlow.hpp"
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+/**
+ * @enum OutputFormat
+ * @brief File formats supported by the solution writers
+ */
+enum class OutputFormat {
+    Csv,   ///< One "from,to,cost,flow" row per edge
+    Json,  ///< Single JSON document with solution header and flow array
+    Binary ///< Little-endian columnar layout, see BinarySolutionWriter
+};
+
+/**
+ * @struct WriterOptions
+ * @brief Settings shared by all solution writers
+ */
+struct WriterOptions {
+    bool sparse;          ///< Only emit edges whose flow exceeds zeroTolerance
+    double zeroTolerance; ///< Flows with magnitude at or below this are zero
+    size_t bufferSize;    ///< Size of the in-memory write buffer in bytes
+
+    /**
+     * @brief Default constructor
+     * Dense output, 1e-6 zero tolerance and a 4 MiB write buffer
+     */
+    WriterOptions()
+        : sparse(false), zeroTolerance(1e-6), bufferSize(size_t(4) << 20) {}
+};
+
+/**
+ * @class SolutionWriter
+ * @brief Base class for solution exporters
+ *
+ * Edges are written in the order returned by NetworkFlow::getEdges(). In
+ * sparse mode only edges carrying a nonzero flow are written.
+ */
+class SolutionWriter {
+protected:
+    WriterOptions options;
+
+    /**
+     * @brief Check whether an edge is written under the current options
+     * @param flow Flow on the edge
+     * @return True if the edge belongs in the output
+     */
+    bool includes(double flow) const;
+
+public:
+    /**
+     * @brief Construct a writer with the given options
+     * @param opts Writer options
+     */
+    explicit SolutionWriter(const WriterOptions &opts);
+
+    virtual ~SolutionWriter() = default;
+
+    /**
+     * @brief Write a solution to an already opened stream
+     * @param net Network the solution belongs to
+     * @param sol Solution to export
+     * @param out Destination stream, left open
+     * @throws std::invalid_argument If the solution does not match the network
+     * @throws std::runtime_error If writing fails
+     */
+    virtual void write(const NetworkFlow &net, const Solution &sol,
+                       std::FILE *out) const = 0;
+
+    /**
+     * @brief Write a solution to a file
+     * @param net Network the solution belongs to
+     * @param sol Solution to export
+     * @param path Output file path, "-" writes to standard output
+     * @throws std::runtime_error If the file cannot be opened or written
+     */
+    void write(const NetworkFlow &net, const Solution &sol,
+               const std::string &path) const;
+};
+
+/**
+ * @class CsvSolutionWriter
+ * @brief Writes a "from,to,cost,flow" header followed by one row per edge
+ */
+class CsvSolutionWriter : public SolutionWriter {
+public:
+    using SolutionWriter::SolutionWriter;
+    using SolutionWriter::write;
+
+    void write(const NetworkFlow &net, const Solution &sol,
+               std::FILE *out) const override;
+};
+
+/**
+ * @class JsonSolutionWriter
+ * @brief Streams the solution as a single JSON object
+ *
+ * The document holds the solution status, total cost, node and edge counts
+ * and a "flows" array of {"edge", "from", "to", "cost", "flow"} objects.
+ */
+class JsonSolutionWriter : public SolutionWriter {
+public:
+    using SolutionWriter::SolutionWriter;
+    using SolutionWriter::write;
+
+    void write(const NetworkFlow &net, const Solution &sol,
+               std::FILE *out) const override;
+};
+
+/**
+ * @class BinarySolutionWriter
+ * @brief Writes the solution in a little-endian columnar binary format
+ *
+ * Layout:
+ * - char[8]  magic "NFSOLBIN"
+ * - uint32   format version (1)
+ * - uint32   flags (bit 0: sparse, bit 1: solved)
+ * - uint64   number of nodes
+ * - uint64   number of rows
+ * - double   total cost
+ * - uint32   status length, followed by the status bytes
+ * - uint64[rows] edge indices (sparse mode only)
+ * - int32[rows]  source nodes
+ * - int32[rows]  destination nodes
+ * - double[rows] flows
+ */
+class BinarySolutionWriter : public SolutionWriter {
+public:
+    using SolutionWriter::SolutionWriter;
+    using SolutionWriter::write;
+
+    void write(const NetworkFlow &net, const Solution &sol,
+               std::FILE *out) const override;
+};
+
+/**
+ * @brief Create a writer for the requested format
+ * @param format Output format
+ * @param opts Writer options
+ * @return Owning pointer to the writer
+ */
+std::unique_ptr<SolutionWriter> makeSolutionWriter(OutputFormat format,
+                                                   const WriterOptions &opts);
+
+/**
+ * @brief Guess the output format from a file name extension
+ * @param path File name ending in .csv, .json or .bin
+ * @return Matching output format
+ * @throws std::invalid_argument If the extension is not recognised
+ */
+OutputFormat formatFromPath(const std::string &path);
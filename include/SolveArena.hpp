@@ -0,0 +1,80 @@
+/**
+ * @file SolveArena.hpp
+ * @brief Per-solve monotonic memory for transient structures
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ *
+ * A solve builds its model and scratch arrays once, uses them until it
+ * returns and then drops everything. Carving all of that from a few large
+ * blocks instead of one heap allocation per array, node or name keeps
+ * allocation out of profiles, and since every solve owns its arena,
+ * concurrent solves no longer contend on the global allocator.
+ */
+
+#pragma once
+
+#include "AllocationTracker.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+/// Vector whose storage comes from a SolveArena
+template <typename T> using ArenaVector = std::pmr::vector<T>;
+
+/**
+ * @class SolveArena
+ * @brief Monotonic std::pmr memory resource owned by one solve
+ *
+ * Memory is handed out by bumping a pointer through blocks obtained from
+ * the global heap, each twice the size of the previous one, and released
+ * in one shot when the arena is destroyed. Deallocation is a no-op, so
+ * containers should be sized once and then reused rather than grown
+ * repeatedly. The arena is not thread-safe; parallel workers allocate
+ * from their own memory.
+ *
+ * An arena created while AllocationTracker is on counts its allocations
+ * through a CountingResource.
+ */
+class SolveArena {
+private:
+    /// Size of the first block when no estimate is given
+    static constexpr size_t MIN_BLOCK = size_t(1) << 16;
+
+    std::pmr::monotonic_buffer_resource resource;
+    CountingResource counting;
+    std::pmr::memory_resource *front; ///< resource, or counting over it
+
+public:
+    /**
+     * @brief Create an arena
+     * @param expectedBytes Expected total allocation; the first block has
+     *        this size so that a good estimate needs a single block
+     */
+    explicit SolveArena(size_t expectedBytes = 0)
+        : resource(std::max(expectedBytes, MIN_BLOCK)), counting(&resource),
+          front(&resource) {
+        if (AllocationTracker::enabled())
+            front = &counting;
+    }
+
+    SolveArena(const SolveArena &) = delete;
+    SolveArena &operator=(const SolveArena &) = delete;
+
+    /**
+     * @brief Memory resource for std::pmr containers
+     * @return Resource valid for the lifetime of the arena
+     */
+    std::pmr::memory_resource *get() { return front; }
+
+    /**
+     * @brief Allocate a vector in the arena
+     * @param size Number of elements
+     * @param value Initial value of every element
+     * @return Vector using the arena for its storage
+     */
+    template <typename T>
+    ArenaVector<T> vector(size_t size = 0, const T &value = T()) {
+        return ArenaVector<T>(size, value, front);
+    }
+};
@@ -0,0 +1,139 @@
+/**
+ * @file Trace.hpp
+ * @brief Timeline of solve phases and worker threads in Chrome trace format
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ *
+ * Code marks a phase with a TraceScope object. While tracing is on, the
+ * scope records a complete event (name, start, duration) into a ring
+ * buffer owned by the recording thread, so threads never contend; while it
+ * is off, a scope costs one relaxed atomic load. Trace::write() dumps the
+ * buffers as Chrome trace JSON, which chrome://tracing and Perfetto
+ * (ui.perfetto.dev) display as one timeline row per thread.
+ *
+ * Buffers of threads that exit are handed to the next new thread, so the
+ * short-lived threads of parallelTasks() reuse a few rows instead of
+ * adding one per parallel call. When a buffer is full the oldest events
+ * are overwritten.
+ *
+ * While AllocationTracker is on, scopes other than "worker" scopes also
+ * mark the phases that allocations are charged to.
+ */
+
+#pragma once
+
+#include "AllocationTracker.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+/**
+ * @class Trace
+ * @brief Process-wide switch and dump of the trace buffers
+ */
+class Trace {
+private:
+    static std::atomic<bool> active;
+
+public:
+    /// Events kept per thread unless start() is given another capacity
+    static constexpr size_t DEFAULT_EVENTS = size_t(1) << 16;
+
+    /**
+     * @brief Discard recorded events and start tracing
+     * @param eventsPerThread Ring buffer capacity of each thread
+     */
+    static void start(size_t eventsPerThread = DEFAULT_EVENTS);
+
+    /**
+     * @brief Stop tracing, keeping the recorded events for write()
+     */
+    static void stop();
+
+    /**
+     * @brief Check whether events are being recorded
+     * @return True between start() and stop()
+     */
+    static bool enabled() { return active.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Current time on the trace clock
+     * @return Nanoseconds since the trace clock started
+     */
+    static int64_t now();
+
+    /**
+     * @brief Record a complete event on the calling thread's buffer
+     * @param name Event name, a string literal or otherwise never freed
+     * @param category Event category, same lifetime rule
+     * @param detail Optional argument shown with the event, or null
+     * @param begin Start time from now()
+     * @param end End time from now()
+     */
+    static void record(const char *name, const char *category,
+                       const char *detail, int64_t begin, int64_t end);
+
+    /**
+     * @brief Write the recorded events as Chrome trace JSON
+     * @param path File to write
+     * @throws std::runtime_error If the file cannot be written
+     *
+     * May be called while tracing; events being recorded during the dump
+     * may be left out.
+     */
+    static void write(const std::string &path);
+};
+
+/**
+ * @class TraceScope
+ * @brief Records the lifetime of a scope as one trace event
+ *
+ * Names must outlive the trace, so pass string literals:
+ * @code
+ * TraceScope scope("presolve");
+ * @endcode
+ */
+class TraceScope {
+private:
+    const char *name;
+    const char *category;
+    const char *detail;
+    int64_t begin; ///< -1 when tracing was off at construction
+    int phase;     ///< Allocation phase to return to, -1 if none was set
+
+public:
+    /**
+     * @brief Start the event
+     * @param eventName Event name
+     * @param eventCategory Category (e.g. "solve", "phase", "worker")
+     * @param eventDetail Optional argument shown with the event
+     */
+    explicit TraceScope(const char *eventName,
+                        const char *eventCategory = "phase",
+                        const char *eventDetail = nullptr)
+        : name(eventName), category(eventCategory), detail(eventDetail),
+          begin(Trace::enabled() ? Trace::now() : -1),
+          phase(AllocationTracker::enabled() &&
+                        std::strcmp(eventCategory, "worker") != 0
+                    ? AllocationTracker::enter(eventName)
+                    : -1) {}
+
+    ~TraceScope() { finish(); }
+
+    /**
+     * @brief End the event before the scope does
+     */
+    void finish() {
+        if (begin >= 0)
+            Trace::record(name, category, detail, begin, Trace::now());
+        if (phase >= 0)
+            AllocationTracker::leave(phase);
+        begin = -1;
+        phase = -1;
+    }
+
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+};
@@ -0,0 +1,66 @@
+/**
+ * @file TransportationSolver.hpp
+ * @brief Native solver reducing uncapacitated networks to transportation
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ */
+
+#pragma once
+
+#include "NetworkFlow.hpp"
+
+/**
+ * @class TransportationSolver
+ * @brief Minimum cost flow via shortest paths between supply and demand
+ *
+ * Without edge capacities, every unit travels along a shortest path from
+ * its supply node to its demand node. The solver
+ * - computes shortest path trees from all supply nodes, a batch of sources
+ *   at a time with multiSourceDistances(), in parallel across batches,
+ * - solves the transportation problem between supply and demand nodes
+ *   with the path lengths as costs (capacity scaling),
+ * - routes each shipment along its shortest path and derives optimal
+ *   potentials from the transportation duals.
+ *
+ * This is fast when supply nodes are few compared to the network size.
+ * Trees can be kept in SolveOptions::distanceCache, so that later solves
+ * with the same topology and costs but new balances skip the searches.
+ * Given SolveOptions::hierarchy, the solver queries it for lengths and
+ * paths instead of computing full trees, which pays off on large sparse
+ * networks with many supply nodes.
+ *
+ * On acyclic networks the trees come from acyclicDistances(), one pass in
+ * topological order per batch, and base potentials from a single
+ * condensedBellmanFord() pass. A single supply node needs no
+ * transportation problem, as it ships every demand along its own tree, so
+ * that solve is linear in the network size on acyclic networks. With S
+ * supply and D demand nodes, the transportation problem has S * D arcs and
+ * is solved by capacity scaling, which takes time superlinear in S * D.
+ */
+class TransportationSolver {
+private:
+    const NetworkFlow &net;
+
+public:
+    /**
+     * @brief Construct a solver for a network
+     * @param network Network to solve, must outlive the solver
+     */
+    explicit TransportationSolver(const NetworkFlow &network);
+
+    /**
+     * @brief Solve the network
+     * @param options Solve options (threads, distance cache, hierarchy)
+     * @return Solution with flows and optimal potentials
+     */
+    Solution solve(const SolveOptions &options) const;
+
+    /**
+     * @brief Check whether a network takes the linear acyclic path
+     * @param network Network to check
+     * @param threads Worker threads for building the graph
+     * @return True if the network keeps its edges in memory, has no
+     *         directed cycle and at most one supply node
+     */
+    static bool linearOnAcyclic(const NetworkFlow &network, unsigned threads);
+};
@@ -0,0 +1,47 @@
+/**
+ * @file TreeSolver.hpp
+ * @brief Closed-form solver for tree and forest shaped networks
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ */
+
+#pragma once
+
+#include "NetworkFlow.hpp"
+
+/**
+ * @class TreeSolver
+ * @brief Minimum cost flow on networks whose undirected graph is a forest
+ *
+ * In a forest, removing an edge splits its tree in two, so the edge must
+ * carry exactly the net supply of the side it leaves; there is only one
+ * feasible flow. The solver
+ * - orders each tree breadth-first from a root, ignoring edge directions,
+ * - sums balances bottom-up, which yields the flow on the edge above every
+ *   node, or proves infeasibility when that flow would run against the
+ *   edge or a tree's balances do not cancel,
+ * - sets potentials top-down so that every edge has zero reduced cost.
+ *
+ * Everything is linear in the number of nodes and works on the original
+ * floating point data, without integer scaling.
+ */
+class TreeSolver {
+private:
+    const NetworkFlow &net;
+
+public:
+    /**
+     * @brief Construct a solver for a network
+     * @param network Network to solve, must outlive the solver
+     */
+    explicit TreeSolver(const NetworkFlow &network);
+
+    /**
+     * @brief Solve the network if it is a forest
+     * @param options Solve options (threads)
+     * @param result Receives the solution, optimal or "Infeasible"
+     * @return False, leaving result untouched, if the network has a cycle
+     *         when edge directions are ignored
+     */
+    bool solve(const SolveOptions &options, Solution &result) const;
+};
@@ -0,0 +1,185 @@
+/**
+ * @file AllocationTracker.cpp
+ * @brief Phase table and the optional global operator new hook
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ *
+ * The phase table is a fixed array of atomic names, constant-initialized,
+ * and the counts live in each thread's current scope, so operator new can
+ * charge allocations before main() and never allocates or locks itself.
+ * Slot 0 is "other", for allocations outside any phase.
+ */
+
+#include "AllocationTracker.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+using namespace std;
+
+std::atomic<bool> AllocationTracker::active(false);
+
+namespace {
+
+atomic<const char *> phases[AllocationTracker::MAX_PHASES];
+atomic<int> phaseCount(1);
+mutex phaseLock;
+
+} // namespace
+
+/**
+ * @brief Start counting allocations
+ */
+void AllocationTracker::start() { active.store(true, memory_order_relaxed); }
+
+/**
+ * @brief Stop counting, keeping the counts
+ */
+void AllocationTracker::stop() { active.store(false, memory_order_relaxed); }
+
+/**
+ * @brief Make a phase current
+ * @param phase Phase name, a string literal or otherwise never freed
+ * @return Token of the previous phase, for leave()
+ *
+ * Phases are matched by name, so scopes with equal names share counts.
+ */
+int AllocationTracker::enter(const char *phase) {
+    const int previous = current;
+    auto find = [&](int count) {
+        for (int i = 1; i < count; ++i)
+            if (strcmp(phases[i].load(memory_order_acquire), phase) == 0)
+                return i;
+        return 0;
+    };
+
+    int slot = find(phaseCount.load(memory_order_acquire));
+    if (slot == 0) {
+        lock_guard<mutex> guard(phaseLock);
+        const int count = phaseCount.load(memory_order_relaxed);
+        slot = find(count);
+        if (slot == 0 && count < static_cast<int>(MAX_PHASES)) {
+            phases[count].store(phase, memory_order_release);
+            phaseCount.store(count + 1, memory_order_release);
+            slot = count;
+        }
+    }
+    current = slot;
+    return previous;
+}
+
+/**
+ * @brief Charge an allocation to the current phase
+ * @param heap True for operator new, false for an arena
+ * @param bytes Requested size
+ */
+void AllocationTracker::charge(bool heap, size_t bytes) {
+    Totals *counts = local;
+    if (!counts)
+        return;
+    (heap ? counts->heapCalls : counts->arenaCalls)[current] += 1;
+    (heap ? counts->heapBytes : counts->arenaBytes)[current] += bytes;
+}
+
+/**
+ * @brief Add counts of finished work to the calling thread's counts
+ * @param counts Counts collected elsewhere, e.g. by a worker thread
+ */
+void AllocationTracker::merge(const Totals &counts) {
+    Totals *into = local;
+    if (!into)
+        return;
+    for (size_t i = 0; i < MAX_PHASES; ++i) {
+        into->heapCalls[i] += counts.heapCalls[i];
+        into->heapBytes[i] += counts.heapBytes[i];
+        into->arenaCalls[i] += counts.arenaCalls[i];
+        into->arenaBytes[i] += counts.arenaBytes[i];
+    }
+}
+
+/**
+ * @brief Name the phases of counts
+ * @param counts Counts of a scope
+ * @return Phases that allocated, in order of first use
+ */
+vector<PhaseAllocations> AllocationTracker::report(const Totals &counts) {
+    vector<PhaseAllocations> used;
+    const int count = phaseCount.load(memory_order_acquire);
+    for (int i = 0; i < count; ++i) {
+        if (counts.heapCalls[i] == 0 && counts.arenaCalls[i] == 0)
+            continue;
+        PhaseAllocations phase;
+        phase.phase = i == 0 ? "other" : phases[i].load();
+        phase.heapCalls = counts.heapCalls[i];
+        phase.heapBytes = counts.heapBytes[i];
+        phase.arenaCalls = counts.arenaCalls[i];
+        phase.arenaBytes = counts.arenaBytes[i];
+        used.push_back(std::move(phase));
+    }
+    return used;
+}
+
+#ifdef NETWORKFLOW_TRACK_ALLOCATIONS
+
+namespace {
+
+void *allocate(size_t bytes, bool nothrow) {
+    AllocationTracker::countHeap(bytes);
+    void *p = std::malloc(bytes ? bytes : 1);
+    if (!p && !nothrow)
+        throw std::bad_alloc();
+    return p;
+}
+
+void *allocateAligned(size_t bytes, align_val_t alignment, bool nothrow) {
+    AllocationTracker::countHeap(bytes);
+    void *p = nullptr;
+    size_t align = max(static_cast<size_t>(alignment), sizeof(void *));
+    if (posix_memalign(&p, align, bytes ? bytes : 1) != 0)
+        p = nullptr;
+    if (!p && !nothrow)
+        throw std::bad_alloc();
+    return p;
+}
+
+} // namespace
+
+void *operator new(size_t bytes) { return allocate(bytes, false); }
+void *operator new[](size_t bytes) { return allocate(bytes, false); }
+void *operator new(size_t bytes, const nothrow_t &) noexcept {
+    return allocate(bytes, true);
+}
+void *operator new[](size_t bytes, const nothrow_t &) noexcept {
+    return allocate(bytes, true);
+}
+void *operator new(size_t bytes, align_val_t alignment) {
+    return allocateAligned(bytes, alignment, false);
+}
+void *operator new[](size_t bytes, align_val_t alignment) {
+    return allocateAligned(bytes, alignment, false);
+}
+void *operator new(size_t bytes, align_val_t alignment,
+                   const nothrow_t &) noexcept {
+    return allocateAligned(bytes, alignment, true);
+}
+void *operator new[](size_t bytes, align_val_t alignment,
+                     const nothrow_t &) noexcept {
+    return allocateAligned(bytes, alignment, true);
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+void operator delete[](void *p, size_t) noexcept { std::free(p); }
+void operator delete(void *p, const nothrow_t &) noexcept { std::free(p); }
+void operator delete[](void *p, const nothrow_t &) noexcept { std::free(p); }
+void operator delete(void *p, align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, size_t, align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, size_t, align_val_t) noexcept {
+    std::free(p);
+}
+
+#endif
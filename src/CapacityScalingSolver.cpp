@@ -0,0 +1,279 @@
+/**
+ * @file CapacityScalingSolver.cpp
+ * @brief Implementation of the capacity scaling solver
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ *
+ * Notation: arc a = (u, v) has scaled cost c[a], flow x[a] >= 0 and reduced
+ * cost r[a] = c[a] + pi[u] - pi[v]. The residual graph has the forward arc
+ * u -> v with unlimited capacity and the backward arc v -> u with capacity
+ * x[a] and cost -r[a]. The Delta-residual graph keeps the residual arcs with
+ * capacity of at least Delta, which is every forward arc and the backward
+ * arcs with x[a] >= Delta. Each phase keeps r >= 0 on all of them.
+ */
+
+#include "CapacityScalingSolver.hpp"
+#include "Counters.hpp"
+#include "NativeSolver.hpp"
+#include "ShortestPath.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+using namespace std;
+
+namespace {
+
+constexpr long long INF = numeric_limits<long long>::max();
+
+/**
+ * @class CapacityScaling
+ * @brief State of one capacity scaling solve
+ */
+class CapacityScaling {
+private:
+    const FlowGraph &g;
+    const Condensation &cond;
+    const vector<long long> &c;
+
+    using Entry = pair<long long, int>;
+
+    ArenaVector<long long> excess;
+
+    // Dijkstra state, valid for nodes whose stamp matches the current search
+    ArenaVector<unsigned> seen;
+    unsigned stamp;
+    ArenaVector<long long> dist;
+    ArenaVector<char> done;
+    ArenaVector<size_t> predArc;
+    ArenaVector<char> predForward;
+    ArenaVector<int> settled;
+    ArenaVector<Entry> heap; ///< Binary min-heap, reused by every search
+
+public:
+    vector<long long> x;
+    vector<long long> pi;
+
+    CapacityScaling(const IntegralInstance &inst, vector<long long> potentials,
+                    SolveArena &arena)
+        : g(inst.graph), cond(inst.condensation), c(inst.cost),
+          excess(inst.supply.begin(), inst.supply.end(), arena.get()),
+          seen(arena.vector<unsigned>(inst.graph.numNodes, 0)), stamp(0),
+          dist(arena.vector<long long>(inst.graph.numNodes)),
+          done(arena.vector<char>(inst.graph.numNodes)),
+          predArc(arena.vector<size_t>(inst.graph.numNodes)),
+          predForward(arena.vector<char>(inst.graph.numNodes)),
+          settled(arena.get()), heap(arena.get()),
+          x(inst.graph.numArcs(), 0), pi(std::move(potentials)) {}
+
+    long long reduced(size_t a) const {
+        return c[a] + pi[g.source[a]] - pi[g.target[a]];
+    }
+
+    /**
+     * @brief Make every forward arc's reduced cost nonnegative
+     * @param threads Worker threads for the shortest path search
+     *
+     * Treats the potentials as distance labels and corrects them with
+     * Bellman-Ford, component by component of the condensation, which is a
+     * single linear pass on acyclic networks. Starting from warm-start
+     * potentials only the arcs whose costs changed need correcting; from
+     * zero this is the usual initialization for negative costs.
+     */
+    void initPotentials(unsigned threads) {
+        pi = condensedBellmanFord(g, cond, c, std::move(pi), threads).dist;
+    }
+
+    /**
+     * @brief Cancel backward arcs that violate the reduced cost invariant
+     * @param delta Scaling parameter of the phase that starts
+     *
+     * Backward arcs with flow between delta and 2 * delta join the residual
+     * graph of the new phase and may have negative reduced cost. Their flow
+     * is sent back, which turns it into surplus and deficit again.
+     */
+    void saturate(long long delta) {
+        for (size_t a = 0; a < x.size(); ++a) {
+            if (x[a] < delta || reduced(a) <= 0)
+                continue;
+            excess[g.source[a]] += x[a];
+            excess[g.target[a]] -= x[a];
+            x[a] = 0;
+        }
+    }
+
+    /**
+     * @brief Find a shortest Delta-residual path to a deficit node
+     * @param s Node with surplus of at least delta
+     * @param delta Scaling parameter
+     * @return Node with deficit of at least delta, or -1 if none is reachable
+     *
+     * Dijkstra on reduced costs, stopped at the first deficit node t. The
+     * potentials of settled nodes are then lowered by dist[t] - dist[v],
+     * which keeps r >= 0 and makes the path arcs balanced.
+     */
+    int shortestPath(int s, long long delta) {
+        const greater<Entry> later;
+        auto push = [&](long long d, int v) {
+            heap.emplace_back(d, v);
+            push_heap(heap.begin(), heap.end(), later);
+            EventCounters::add(Counter::HeapPushes);
+        };
+
+        ++stamp;
+        heap.clear();
+        settled.clear();
+        auto reach = [&](int v, long long d, size_t a, bool forward) {
+            if (seen[v] == stamp && (done[v] || dist[v] <= d))
+                return;
+            if (seen[v] != stamp) {
+                seen[v] = stamp;
+                done[v] = 0;
+            }
+            dist[v] = d;
+            predArc[v] = a;
+            predForward[v] = forward;
+            push(d, v);
+        };
+        seen[s] = stamp;
+        done[s] = 0;
+        dist[s] = 0;
+        push(0, s);
+
+        int t = -1;
+        while (!heap.empty()) {
+            pop_heap(heap.begin(), heap.end(), later);
+            auto [d, u] = heap.back();
+            heap.pop_back();
+            EventCounters::add(Counter::HeapPops);
+            if (done[u] || d != dist[u])
+                continue;
+            done[u] = 1;
+            settled.push_back(u);
+            if (excess[u] <= -delta) {
+                t = u;
+                break;
+            }
+            for (size_t i = g.outBegin[u]; i < g.outBegin[u + 1]; ++i) {
+                size_t a = g.outArcs[i];
+                reach(g.target[a], d + reduced(a), a, true);
+            }
+            for (size_t i = g.inBegin[u]; i < g.inBegin[u + 1]; ++i) {
+                size_t a = g.inArcs[i];
+                if (x[a] >= delta)
+                    reach(g.source[a], d - reduced(a), a, false);
+            }
+        }
+        if (t < 0)
+            return -1;
+
+        for (int v : settled)
+            pi[v] += dist[v] - dist[t];
+        EventCounters::add(Counter::Relabels, settled.size());
+        return t;
+    }
+
+    /**
+     * @brief Augment along the path found by shortestPath()
+     * @param s Start of the path
+     * @param t End of the path
+     *
+     * Sends as much as the endpoints and backward arcs allow, which is at
+     * least delta.
+     */
+    void augment(int s, int t) {
+        long long amount = min(excess[s], -excess[t]);
+        for (int v = t; v != s;) {
+            size_t a = predArc[v];
+            if (predForward[v]) {
+                v = g.source[a];
+            } else {
+                amount = min(amount, x[a]);
+                v = g.target[a];
+            }
+        }
+        for (int v = t; v != s;) {
+            size_t a = predArc[v];
+            if (predForward[v]) {
+                x[a] += amount;
+                v = g.source[a];
+            } else {
+                x[a] -= amount;
+                v = g.target[a];
+            }
+        }
+        excess[s] -= amount;
+        excess[t] += amount;
+        EventCounters::add(Counter::Augmentations);
+    }
+
+    /**
+     * @brief Run all scaling phases
+     * @return False if some surplus cannot reach any deficit
+     *
+     * A surplus node that cannot reach a large enough deficit in the
+     * Delta-residual graph waits for a later phase. In the last phase
+     * (Delta = 1) the residual graph is complete, so failing there proves
+     * that no feasible flow exists.
+     */
+    bool run() {
+        long long largest = 0;
+        for (long long e : excess)
+            largest = max(largest, e < 0 ? -e : e);
+        long long delta = 1;
+        while (delta <= largest / 2)
+            delta *= 2;
+
+        for (; delta >= 1; delta /= 2) {
+            saturate(delta);
+            for (int s = 0; s < g.numNodes; ++s) {
+                while (excess[s] >= delta) {
+                    int t = shortestPath(s, delta);
+                    if (t < 0) {
+                        if (delta == 1)
+                            return false;
+                        break;
+                    }
+                    augment(s, t);
+                }
+            }
+        }
+        return true;
+    }
+};
+
+} // namespace
+
+/**
+ * @brief Construct a solver for a network
+ * @param network Network to solve, must outlive the solver
+ */
+CapacityScalingSolver::CapacityScalingSolver(const NetworkFlow &network)
+    : net(network) {}
+
+/**
+ * @brief Solve the network
+ * @param options Solve options (threads, warm-start potentials)
+ * @return Solution with flows and optimal potentials
+ *
+ * Returns status "Infeasible" or "Unbounded" without flows when the network
+ * has no optimal solution, and explains why if the data cannot be scaled to
+ * integers.
+ */
+Solution CapacityScalingSolver::solve(const SolveOptions &options) const {
+    Solution result;
+    IntegralInstance inst(net, options.threads, options.nodeOrder);
+    if (!nativePrecheck(net, inst, result, options.threads))
+        return result;
+    TraceScope trace("capacity scaling", "engine");
+
+    SolveArena arena(arenaBytes(inst));
+    CapacityScaling scaling(inst, scaledPotentials(options, inst), arena);
+    scaling.initPotentials(options.threads);
+    if (!scaling.run()) {
+        result.status = "Infeasible";
+        return result;
+    }
+    return nativeSolution(net, inst, scaling.x, scaling.pi);
+}
@@ -0,0 +1,140 @@
+/**
+ * @file Condensation.cpp
+ * @brief Implementation of the strongly connected component analysis
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ */
+
+#include "Condensation.hpp"
+#include <algorithm>
+#include <utility>
+
+using namespace std;
+
+/**
+ * @brief Compute the components
+ * @param g Graph
+ *
+ * Tarjan's algorithm with an explicit stack of (node, next arc) frames, so
+ * long paths cannot overflow the call stack. It completes components in
+ * reverse topological order; numbering them from the back yields the
+ * topological numbering.
+ */
+Condensation::Condensation(const FlowGraph &g)
+    : numComponents(0), innerArcs(0) {
+    const int n = g.numNodes;
+    vector<int> index(n, -1), low(n, 0), stack;
+    vector<char> onStack(n, 0);
+    vector<pair<int, size_t>> frames;
+    component.assign(n, -1);
+    nodes.reserve(n);
+    begin.push_back(0);
+    int counter = 0;
+
+    auto open = [&](int v) {
+        index[v] = low[v] = counter++;
+        stack.push_back(v);
+        onStack[v] = 1;
+        frames.emplace_back(v, g.outBegin[v]);
+    };
+
+    for (int root = 0; root < n; ++root) {
+        if (index[root] >= 0)
+            continue;
+        open(root);
+        while (!frames.empty()) {
+            const int v = frames.back().first;
+            size_t &pos = frames.back().second;
+            bool descended = false;
+            while (pos < g.outBegin[v + 1]) {
+                int w = g.target[g.outArcs[pos++]];
+                if (index[w] < 0) {
+                    open(w);
+                    descended = true;
+                    break;
+                }
+                if (onStack[w])
+                    low[v] = min(low[v], index[w]);
+            }
+            if (descended)
+                continue;
+
+            if (low[v] == index[v]) {
+                int w;
+                do {
+                    w = stack.back();
+                    stack.pop_back();
+                    onStack[w] = 0;
+                    component[w] = numComponents;
+                    nodes.push_back(w);
+                } while (w != v);
+                begin.push_back(nodes.size());
+                ++numComponents;
+            }
+            frames.pop_back();
+            if (!frames.empty()) {
+                int parent = frames.back().first;
+                low[parent] = min(low[parent], low[v]);
+            }
+        }
+    }
+
+    // Reverse the completion order into a topological one
+    const int last = numComponents - 1;
+    for (int &c : component)
+        c = last - c;
+    vector<int> grouped;
+    grouped.reserve(nodes.size());
+    vector<size_t> starts(1, 0);
+    for (int c = last; c >= 0; --c) {
+        grouped.insert(grouped.end(), nodes.begin() + begin[c],
+                       nodes.begin() + begin[c + 1]);
+        starts.push_back(grouped.size());
+    }
+    nodes = std::move(grouped);
+    begin = std::move(starts);
+
+    for (size_t a = 0; a < g.numArcs(); ++a)
+        if (component[g.source[a]] == component[g.target[a]])
+            ++innerArcs;
+}
+
+/**
+ * @brief Number of nodes in the largest component
+ * @return Node count, 0 for an empty graph
+ */
+size_t Condensation::largest() const {
+    size_t most = 0;
+    for (int c = 0; c < numComponents; ++c)
+        most = max(most, size(c));
+    return most;
+}
+
+/**
+ * @brief Subgraph of the arcs that lie inside components
+ * @param g Graph
+ * @param cond Components of g
+ * @param arcs Receives the arc of g for each arc of the subgraph
+ * @param threads Worker threads, 0 for hardware concurrency
+ * @return Graph on the same nodes holding only arcs that can lie on cycles
+ */
+FlowGraph innerSubgraph(const FlowGraph &g, const Condensation &cond,
+                        vector<size_t> &arcs, unsigned threads) {
+    arcs.clear();
+    arcs.reserve(cond.innerArcs);
+    vector<int> source, target;
+    vector<double> cost;
+    source.reserve(cond.innerArcs);
+    target.reserve(cond.innerArcs);
+    cost.reserve(cond.innerArcs);
+    for (size_t a = 0; a < g.numArcs(); ++a) {
+        if (cond.component[g.source[a]] != cond.component[g.target[a]])
+            continue;
+        arcs.push_back(a);
+        source.push_back(g.source[a]);
+        target.push_back(g.target[a]);
+        cost.push_back(g.cost[a]);
+    }
+    return FlowGraph(g.numNodes, std::move(source), std::move(target),
+                     std::move(cost), threads);
+}
@@ -0,0 +1,715 @@
+/**
+ * @file ContractionHierarchy.cpp
+ * @brief Construction, customization and queries of the hierarchy
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ *
+ * File format (native byte order): "NFHIERCH", uint32 version, uint32
+ * flags (1 = complete), uint64 topology hash, uint64 node count, uint64
+ * edge count, then int32 rank per node, uint64 upBegin per node plus one
+ * and int32 upNode per edge.
+ */
+
+#include "ContractionHierarchy.hpp"
+#include "ShortestPath.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+
+constexpr char MAGIC[8] = {'N', 'F', 'H', 'I', 'E', 'R', 'C', 'H'};
+constexpr uint32_t VERSION = 1;
+constexpr long long FAR = unreachableDistance<long long>();
+
+/**
+ * @class HierarchyFile
+ * @brief Binary file that throws on short reads and writes
+ */
+class HierarchyFile {
+private:
+    std::FILE *file;
+    string path;
+
+public:
+    HierarchyFile(const string &filePath, const char *mode)
+        : file(std::fopen(filePath.c_str(), mode)), path(filePath) {
+        if (!file)
+            throw std::runtime_error("Cannot open hierarchy file: " + path);
+    }
+
+    ~HierarchyFile() {
+        if (file)
+            std::fclose(file);
+    }
+
+    HierarchyFile(const HierarchyFile &) = delete;
+    HierarchyFile &operator=(const HierarchyFile &) = delete;
+
+    void write(const void *data, size_t bytes) {
+        if (bytes > 0 && std::fwrite(data, 1, bytes, file) != bytes)
+            throw std::runtime_error("Failed to write hierarchy file: " +
+                                     path);
+    }
+
+    void read(void *data, size_t bytes) {
+        if (bytes > 0 && std::fread(data, 1, bytes, file) != bytes)
+            throw std::runtime_error("Truncated hierarchy file: " + path);
+    }
+
+    uint64_t remaining() {
+        const long here = std::ftell(file);
+        if (here < 0 || std::fseek(file, 0, SEEK_END) != 0)
+            throw std::runtime_error("Cannot seek in hierarchy file: " +
+                                     path);
+        const long end = std::ftell(file);
+        if (end < here || std::fseek(file, here, SEEK_SET) != 0)
+            throw std::runtime_error("Cannot seek in hierarchy file: " +
+                                     path);
+        return static_cast<uint64_t>(end - here);
+    }
+
+    template <typename T> void put(T value) { write(&value, sizeof(T)); }
+
+    template <typename T> T get() {
+        T value;
+        read(&value, sizeof(T));
+        return value;
+    }
+
+    void close() {
+        std::FILE *f = file;
+        file = nullptr;
+        if (std::fclose(f) != 0)
+            throw std::runtime_error("Failed to close hierarchy file: " +
+                                     path);
+    }
+};
+
+/**
+ * @brief Check the structure that customization and searches rely on
+ * @param rank Rank per node
+ * @param begin Start of each node's upward edges, plus the end
+ * @param node Upper endpoint per edge
+ * @return True if rank is a permutation, every list is sorted by rank
+ *         above its node, and the upward neighbours of every node are
+ *         joined pairwise by edges of the lower ranked one
+ *
+ * The last condition makes every upward neighbour an ancestor in the
+ * elimination tree. It is checked by the same merge customize() does.
+ */
+bool validHierarchy(const vector<int32_t> &rank,
+                    const vector<uint64_t> &begin,
+                    const vector<int32_t> &node) {
+    const uint64_t n = rank.size();
+    const uint64_t edges = node.size();
+    if (begin[0] != 0 || begin[n] != edges)
+        return false;
+    vector<char> taken(n, 0);
+    for (uint64_t v = 0; v < n; ++v) {
+        if (rank[v] < 0 || static_cast<uint64_t>(rank[v]) >= n ||
+            taken[rank[v]] || begin[v] > begin[v + 1] || begin[v + 1] > edges)
+            return false;
+        taken[rank[v]] = 1;
+        for (uint64_t e = begin[v]; e < begin[v + 1]; ++e)
+            if (node[e] < 0 || static_cast<uint64_t>(node[e]) >= n)
+                return false;
+    }
+    for (uint64_t v = 0; v < n; ++v)
+        for (uint64_t e = begin[v]; e < begin[v + 1]; ++e)
+            if (rank[node[e]] <= rank[v] ||
+                (e > begin[v] && rank[node[e - 1]] >= rank[node[e]]))
+                return false;
+    for (uint64_t v = 0; v < n; ++v) {
+        for (uint64_t i = begin[v]; i < begin[v + 1]; ++i) {
+            const int low = node[i];
+            uint64_t e = begin[low];
+            for (uint64_t j = i + 1; j < begin[v + 1]; ++j) {
+                while (e < begin[low + 1] && rank[node[e]] < rank[node[j]])
+                    ++e;
+                if (e == begin[low + 1] || node[e] != node[j])
+                    return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Undirected simple graph of a topology
+ * @param g Graph topology
+ * @return Sorted neighbour list per node, without loops and duplicates
+ */
+vector<vector<int>> undirectedNeighbours(const FlowGraph &g) {
+    vector<vector<int>> adj(g.numNodes);
+    for (size_t a = 0; a < g.numArcs(); ++a) {
+        if (g.source[a] == g.target[a])
+            continue;
+        adj[g.source[a]].push_back(g.target[a]);
+        adj[g.target[a]].push_back(g.source[a]);
+    }
+    for (auto &list : adj) {
+        sort(list.begin(), list.end());
+        list.erase(unique(list.begin(), list.end()), list.end());
+    }
+    return adj;
+}
+
+/// Parts up to this size are not dissected further
+constexpr size_t LEAF_SIZE = 32;
+
+/**
+ * @brief Breadth-first search within one part
+ * @param adj Undirected neighbour lists
+ * @param label Part of each node
+ * @param start First node
+ * @param level Depth per node, -1 for nodes not visited yet
+ * @param visited Receives the reached nodes in visiting order
+ */
+void partBfs(const vector<vector<int>> &adj, const vector<int> &label,
+             int start, vector<int> &level, vector<int> &visited) {
+    visited.assign(1, start);
+    level[start] = 0;
+    for (size_t i = 0; i < visited.size(); ++i) {
+        int v = visited[i];
+        for (int w : adj[v]) {
+            if (label[w] == label[start] && level[w] < 0) {
+                level[w] = level[v] + 1;
+                visited.push_back(w);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Nested dissection order of the undirected topology
+ * @param adj Undirected neighbour lists
+ * @return Nodes in contraction order
+ *
+ * Each connected part is split at a BFS level from a pseudo-peripheral
+ * node, the level where half of the part has been visited. The nodes of
+ * that level with a neighbour on the level above form the separator, the
+ * rest join the lower half. Separators are contracted after the parts
+ * they separate, so positions are handed out from the end while parts
+ * are split.
+ */
+vector<int> nestedDissection(const vector<vector<int>> &adj) {
+    const size_t n = adj.size();
+    vector<int> order(n), label(n, 0), level(n, -1), visited, component;
+    vector<int> parts; // One node per connected part, labels tell them apart
+    size_t end = n;
+    int labels = 1;
+
+    // Give every connected component among nodes its own label
+    auto split = [&](const vector<int> &nodes) {
+        for (int v : nodes) {
+            if (label[v] < 0 || level[v] >= 0)
+                continue;
+            partBfs(adj, label, v, level, component);
+            for (int w : component)
+                label[w] = labels;
+            ++labels;
+            parts.push_back(v);
+        }
+        for (int v : nodes)
+            level[v] = -1;
+    };
+
+    vector<int> all(n);
+    for (size_t v = 0; v < n; ++v)
+        all[v] = static_cast<int>(v);
+    split(all);
+
+    while (!parts.empty()) {
+        int start = parts.back();
+        parts.pop_back();
+
+        // The last node of a BFS is far from the others
+        partBfs(adj, label, start, level, visited);
+        for (int v : visited)
+            level[v] = -1;
+        partBfs(adj, label, visited.back(), level, visited);
+
+        if (visited.size() <= LEAF_SIZE) {
+            for (int v : visited) {
+                order[--end] = v;
+                label[v] = -1;
+                level[v] = -1;
+            }
+            continue;
+        }
+
+        // Narrowest level with at least a third of the part on each side
+        const int depth = level[visited.back()];
+        vector<size_t> width(depth + 1, 0);
+        for (int v : visited)
+            ++width[level[v]];
+        int middle = min(level[visited[visited.size() / 2]], depth - 1);
+        size_t below = 0;
+        for (int l = 0; l < depth; ++l) {
+            size_t above = visited.size() - below - width[l];
+            if (3 * below >= visited.size() &&
+                3 * above >= visited.size() && width[l] < width[middle])
+                middle = l;
+            below += width[l];
+        }
+        const int lower = labels++, upper = labels++;
+        for (int v : visited) {
+            bool separates = false;
+            if (level[v] == middle)
+                for (int w : adj[v])
+                    separates = separates || level[w] > middle;
+            if (separates) {
+                order[--end] = v;
+                label[v] = -1;
+            } else {
+                label[v] = level[v] <= middle ? lower : upper;
+            }
+        }
+        for (int v : visited)
+            level[v] = -1;
+        split(visited);
+    }
+    return order;
+}
+
+} // namespace
+
+ContractionHierarchy::ContractionHierarchy()
+    : hash(0), numNodes(0), complete(false) {}
+
+/**
+ * @brief Contract the topology of a graph
+ * @param g Graph topology
+ * @param maxFill Give up once the hierarchy would have more than maxFill
+ *        times as many edges as the undirected topology
+ *
+ * Every edge left in the remaining graph ends up as a hierarchy edge, so
+ * the edges stored so far plus the remaining ones bound the final size
+ * from below and the limit is checked after every contraction.
+ */
+ContractionHierarchy::ContractionHierarchy(const FlowGraph &g, double maxFill)
+    : hash(topologyHash(g)), numNodes(g.numNodes), complete(false) {
+    const size_t n = static_cast<size_t>(numNodes);
+
+    vector<vector<int>> adj = undirectedNeighbours(g);
+    size_t remaining = 0;
+    for (const auto &list : adj)
+        remaining += list.size();
+    remaining /= 2;
+    const double limit =
+        max(maxFill * static_cast<double>(remaining), static_cast<double>(n));
+
+    const vector<int> order = nestedDissection(adj);
+    rank.assign(n, -1);
+    for (size_t i = 0; i < n; ++i)
+        rank[order[i]] = static_cast<int>(i);
+
+    vector<vector<int>> up(n);
+    vector<int> merged;
+    size_t stored = 0;
+    for (int v : order) {
+        // The remaining neighbours become a clique
+        const vector<int> &around = adj[v];
+        size_t added = 0;
+        for (int w : around) {
+            merged.clear();
+            auto it = adj[w].begin(), end = adj[w].end();
+            for (int x : around) {
+                for (; it != end && *it < x; ++it)
+                    if (*it != v)
+                        merged.push_back(*it);
+                if (it != end && *it == x)
+                    ++it;
+                if (x != w)
+                    merged.push_back(x);
+            }
+            for (; it != end; ++it)
+                if (*it != v)
+                    merged.push_back(*it);
+            added += merged.size() + 1 - adj[w].size();
+            adj[w].swap(merged);
+        }
+
+        stored += around.size();
+        remaining -= around.size();
+        remaining += added / 2;
+        if (static_cast<double>(stored + remaining) > limit) {
+            rank.clear();
+            return;
+        }
+        up[v].swap(adj[v]);
+    }
+
+    upBegin.assign(n + 1, 0);
+    for (size_t v = 0; v < n; ++v)
+        upBegin[v + 1] = upBegin[v] + up[v].size();
+    upNode.reserve(upBegin[n]);
+    for (auto &list : up) {
+        sort(list.begin(), list.end(),
+             [&](int x, int w) { return rank[x] < rank[w]; });
+        upNode.insert(upNode.end(), list.begin(), list.end());
+        vector<int>().swap(list);
+    }
+    complete = true;
+    finish();
+}
+
+/**
+ * @brief Derive lower endpoints and the elimination tree from the edges
+ */
+void ContractionHierarchy::finish() {
+    const size_t n = static_cast<size_t>(numNodes);
+    edgeLow.resize(upNode.size());
+    parent.assign(n, -1);
+    for (size_t v = 0; v < n; ++v) {
+        for (size_t e = upBegin[v]; e < upBegin[v + 1]; ++e) {
+            edgeLow[e] = static_cast<int>(v);
+            int w = upNode[e];
+            if (parent[v] < 0 || rank[w] < rank[parent[v]])
+                parent[v] = w;
+        }
+    }
+}
+
+/**
+ * @brief Read a hierarchy written by save()
+ * @param path File to read
+ * @return Hierarchy stored in the file
+ * @throws std::runtime_error If the file cannot be read or is invalid
+ */
+ContractionHierarchy ContractionHierarchy::load(const string &path) {
+    HierarchyFile in(path, "rb");
+    char magic[sizeof(MAGIC)];
+    in.read(magic, sizeof(magic));
+    if (memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        in.get<uint32_t>() != VERSION)
+        throw std::runtime_error("Not a hierarchy file: " + path);
+
+    ContractionHierarchy ch;
+    ch.complete = (in.get<uint32_t>() & 1) != 0;
+    ch.hash = in.get<uint64_t>();
+    const uint64_t n = in.get<uint64_t>();
+    const uint64_t edges = in.get<uint64_t>();
+    if (n > static_cast<uint64_t>(numeric_limits<int>::max()) ||
+        edges > n * n)
+        throw std::runtime_error("Invalid hierarchy file: " + path);
+    ch.numNodes = static_cast<int>(n);
+    if (!ch.complete)
+        return ch;
+
+    // Counts must match the file before they size any allocation
+    const uint64_t fixed = n * sizeof(int32_t) + (n + 1) * sizeof(uint64_t);
+    const uint64_t bytes = in.remaining();
+    if (bytes < fixed || (bytes - fixed) / sizeof(int32_t) != edges ||
+        (bytes - fixed) % sizeof(int32_t) != 0)
+        throw std::runtime_error("Invalid hierarchy file: " + path);
+
+    vector<int32_t> rank(n), node(edges);
+    vector<uint64_t> begin(n + 1);
+    in.read(rank.data(), rank.size() * sizeof(int32_t));
+    in.read(begin.data(), begin.size() * sizeof(uint64_t));
+    in.read(node.data(), node.size() * sizeof(int32_t));
+    if (!validHierarchy(rank, begin, node))
+        throw std::runtime_error("Invalid hierarchy file: " + path);
+
+    ch.rank.assign(rank.begin(), rank.end());
+    ch.upBegin.assign(begin.begin(), begin.end());
+    ch.upNode.assign(node.begin(), node.end());
+    ch.finish();
+    return ch;
+}
+
+/**
+ * @brief Write the hierarchy to a binary file
+ * @param path File to write
+ * @throws std::runtime_error If the file cannot be written
+ */
+void ContractionHierarchy::save(const string &path) const {
+    HierarchyFile out(path, "wb");
+    out.write(MAGIC, sizeof(MAGIC));
+    out.put<uint32_t>(VERSION);
+    out.put<uint32_t>(complete ? 1 : 0);
+    out.put<uint64_t>(hash);
+    out.put<uint64_t>(static_cast<uint64_t>(numNodes));
+    out.put<uint64_t>(upNode.size());
+    if (complete) {
+        vector<int32_t> ranks(rank.begin(), rank.end());
+        vector<uint64_t> begin(upBegin.begin(), upBegin.end());
+        vector<int32_t> node(upNode.begin(), upNode.end());
+        out.write(ranks.data(), ranks.size() * sizeof(int32_t));
+        out.write(begin.data(), begin.size() * sizeof(uint64_t));
+        out.write(node.data(), node.size() * sizeof(int32_t));
+    }
+    out.close();
+}
+
+/**
+ * @brief Check whether the hierarchy was built for a graph's topology
+ * @param g Graph topology
+ * @return True if node count and arcs match
+ */
+bool ContractionHierarchy::matches(const FlowGraph &g) const {
+    return numNodes == g.numNodes && hash == topologyHash(g);
+}
+
+/**
+ * @brief Find the hierarchy edge between two nodes
+ * @param low Lower ranked endpoint
+ * @param high Higher ranked endpoint
+ * @return Edge index, NO_ARC if the nodes are not adjacent
+ */
+size_t ContractionHierarchy::findEdge(int low, int high) const {
+    auto first = upNode.begin() + static_cast<ptrdiff_t>(upBegin[low]);
+    auto last = upNode.begin() + static_cast<ptrdiff_t>(upBegin[low + 1]);
+    auto it = lower_bound(first, last, high,
+                          [&](int x, int w) { return rank[x] < rank[w]; });
+    if (it == last || *it != high)
+        return NO_ARC;
+    return static_cast<size_t>(it - upNode.begin());
+}
+
+/**
+ * @brief Lower the length of a directed hierarchy edge to an arc's cost
+ * @param metric Metric being customized
+ * @param arc Original arc
+ * @param from Tail of the arc
+ * @param to Head of the arc
+ * @param length Cost of the arc
+ * @throws std::runtime_error If the hierarchy has no edge for the arc
+ */
+void ContractionHierarchy::relax(HierarchyMetric &metric, size_t arc,
+                                 int from, int to, long long length) const {
+    const size_t e =
+        rank[from] < rank[to] ? findEdge(from, to) : findEdge(to, from);
+    if (e == NO_ARC)
+        throw std::runtime_error(
+            "Contraction hierarchy does not match the graph");
+    if (rank[from] < rank[to]) {
+        if (length < metric.upLength[e]) {
+            metric.upLength[e] = length;
+            metric.upArc[e] = arc;
+        }
+    } else {
+        if (length < metric.downLength[e]) {
+            metric.downLength[e] = length;
+            metric.downArc[e] = arc;
+        }
+    }
+}
+
+/**
+ * @brief Compute the hierarchy edge lengths for a cost vector
+ * @param g Graph topology the hierarchy matches
+ * @param cost Cost per arc, without negative cycles
+ * @return Metric for search() and path()
+ * @throws std::runtime_error If an arc has no hierarchy edge
+ *
+ * Every arc sets the length of its own edge. Nodes are then visited in
+ * increasing rank; a path w1 -> v -> w2 through v bounds the edge between
+ * two upward neighbours of v. Those edges belong to higher ranked nodes,
+ * and all paths through lower ranked nodes were applied to v's edges
+ * before, so one pass gives every up-down path its shortest length.
+ */
+HierarchyMetric
+ContractionHierarchy::customize(const FlowGraph &g,
+                                const vector<long long> &cost) const {
+    const size_t n = static_cast<size_t>(numNodes);
+    const size_t edges = upNode.size();
+    HierarchyMetric metric;
+    metric.upLength.assign(edges, FAR);
+    metric.downLength.assign(edges, FAR);
+    metric.upArc.assign(edges, NO_ARC);
+    metric.downArc.assign(edges, NO_ARC);
+    metric.upVia.assign(edges, -1);
+    metric.downVia.assign(edges, -1);
+
+    for (size_t a = 0; a < g.numArcs(); ++a)
+        if (g.source[a] != g.target[a])
+            relax(metric, a, g.source[a], g.target[a], cost[a]);
+
+    vector<int> byRank(n);
+    for (size_t v = 0; v < n; ++v)
+        byRank[rank[v]] = static_cast<int>(v);
+    auto &up = metric.upLength;
+    auto &down = metric.downLength;
+    for (int v : byRank) {
+        for (size_t i = upBegin[v]; i < upBegin[v + 1]; ++i) {
+            // The edges from upNode[i] to the later neighbours of v appear
+            // in the same order in its own list
+            const int low = upNode[i];
+            size_t e = upBegin[low];
+            for (size_t j = i + 1; j < upBegin[v + 1]; ++j) {
+                while (upNode[e] != upNode[j])
+                    ++e;
+                if (down[i] != FAR && up[j] != FAR &&
+                    down[i] + up[j] < up[e]) {
+                    up[e] = down[i] + up[j];
+                    metric.upArc[e] = NO_ARC;
+                    metric.upVia[e] = v;
+                }
+                if (down[j] != FAR && up[i] != FAR &&
+                    down[j] + up[i] < down[e]) {
+                    down[e] = down[j] + up[i];
+                    metric.downArc[e] = NO_ARC;
+                    metric.downVia[e] = v;
+                }
+            }
+        }
+    }
+    return metric;
+}
+
+/**
+ * @brief Search from or to a node
+ * @param metric Edge lengths from customize()
+ * @param v Start node (0-indexed)
+ * @param forward True for distances from v, false for distances to v
+ * @param result Receives the labels
+ *
+ * The labels of the elimination tree path from v to its root are relaxed
+ * in rank order, which is a topological order of the upward edges.
+ */
+void ContractionHierarchy::search(const HierarchyMetric &metric, int v,
+                                  bool forward,
+                                  HierarchySearch &result) const {
+    const vector<long long> &length =
+        forward ? metric.upLength : metric.downLength;
+    result.node.clear();
+    result.rank.clear();
+    for (int x = v; x >= 0; x = parent[x]) {
+        result.node.push_back(x);
+        result.rank.push_back(rank[x]);
+    }
+    const size_t size = result.node.size();
+    result.dist.assign(size, FAR);
+    result.edge.assign(size, NO_ARC);
+    result.dist[0] = 0;
+
+    // Upward neighbours come in rank order, so each one is searched for
+    // by galloping from the position of the previous one
+    const int *chain = result.rank.data();
+    for (size_t i = 0; i < size; ++i) {
+        if (result.dist[i] == FAR)
+            continue;
+        size_t j = i + 1;
+        for (size_t e = upBegin[result.node[i]];
+             e < upBegin[result.node[i] + 1]; ++e) {
+            const int r = rank[upNode[e]];
+            size_t bound = 1;
+            while (j + bound < size && chain[j + bound] < r)
+                bound *= 2;
+            j = static_cast<size_t>(
+                lower_bound(chain + j + bound / 2,
+                            chain + min(j + bound + 1, size), r) -
+                chain);
+            if (length[e] != FAR &&
+                result.dist[i] + length[e] < result.dist[j]) {
+                result.dist[j] = result.dist[i] + length[e];
+                result.edge[j] = e;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Length of a shortest path
+ * @param from Forward search of the first node
+ * @param to Backward search of the last node
+ * @param meeting Receives the highest ranked node of the path, or -1
+ * @return Path length, unreachableDistance() if there is no path
+ */
+long long ContractionHierarchy::distance(const HierarchySearch &from,
+                                         const HierarchySearch &to,
+                                         int *meeting) const {
+    long long best = FAR;
+    int top = -1;
+    for (size_t i = 0, j = 0; i < from.node.size() && j < to.node.size();) {
+        int ri = from.rank[i], rj = to.rank[j];
+        if (ri < rj) {
+            ++i;
+        } else if (rj < ri) {
+            ++j;
+        } else {
+            if (from.dist[i] != FAR && to.dist[j] != FAR &&
+                from.dist[i] + to.dist[j] < best) {
+                best = from.dist[i] + to.dist[j];
+                top = from.node[i];
+            }
+            ++i;
+            ++j;
+        }
+    }
+    if (meeting)
+        *meeting = top;
+    return best;
+}
+
+/**
+ * @brief Append the original arcs of a directed hierarchy edge
+ * @param metric Edge lengths of the customization
+ * @param e Hierarchy edge
+ * @param up True for the lower to higher direction
+ * @param arcs Receives the arcs in path order
+ *
+ * A shortcut from a to b through m is replaced by the edges a -> m and
+ * m -> b, both with a lower ranked low endpoint, until only arcs remain.
+ */
+void ContractionHierarchy::unpack(const HierarchyMetric &metric, size_t e,
+                                  bool up, vector<size_t> &arcs) const {
+    vector<pair<size_t, bool>> stack{{e, up}};
+    while (!stack.empty()) {
+        auto [edge, upward] = stack.back();
+        stack.pop_back();
+        size_t arc = upward ? metric.upArc[edge] : metric.downArc[edge];
+        if (arc != NO_ARC) {
+            arcs.push_back(arc);
+            continue;
+        }
+        int via = upward ? metric.upVia[edge] : metric.downVia[edge];
+        int tail = upward ? edgeLow[edge] : upNode[edge];
+        int head = upward ? upNode[edge] : edgeLow[edge];
+        stack.emplace_back(findEdge(via, head), true);
+        stack.emplace_back(findEdge(via, tail), false);
+    }
+}
+
+/**
+ * @brief Append the arcs of a shortest path
+ * @param metric Edge lengths the searches used
+ * @param from Forward search of the first node
+ * @param to Backward search of the last node
+ * @param arcs Receives the original arcs of the path, in order
+ * @return False if there is no path
+ */
+bool ContractionHierarchy::path(const HierarchyMetric &metric,
+                                const HierarchySearch &from,
+                                const HierarchySearch &to,
+                                vector<size_t> &arcs) const {
+    int top;
+    if (distance(from, to, &top) == FAR)
+        return false;
+
+    auto position = [&](const HierarchySearch &s, int v) {
+        return static_cast<size_t>(
+            lower_bound(s.rank.begin(), s.rank.end(), rank[v]) -
+            s.rank.begin());
+    };
+
+    vector<size_t> upward;
+    for (size_t i = position(from, top); from.edge[i] != NO_ARC;) {
+        upward.push_back(from.edge[i]);
+        i = position(from, edgeLow[from.edge[i]]);
+    }
+    for (auto it = upward.rbegin(); it != upward.rend(); ++it)
+        unpack(metric, *it, true, arcs);
+    for (size_t i = position(to, top); to.edge[i] != NO_ARC;) {
+        unpack(metric, to.edge[i], false, arcs);
+        i = position(to, edgeLow[to.edge[i]]);
+    }
+    return true;
+}
@@ -0,0 +1,35 @@
+/**
+ * @file Counters.cpp
+ * @brief Names of the event counters
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ */
+
+#include "Counters.hpp"
+
+/**
+ * @brief Name of a counter for reports
+ * @param c Counter kind
+ * @return Snake case name such as "degenerate_pivots"
+ */
+const char *SolveCounters::name(Counter c) {
+    switch (c) {
+    case Counter::Pivots:
+        return "pivots";
+    case Counter::DegeneratePivots:
+        return "degenerate_pivots";
+    case Counter::ArcsPriced:
+        return "arcs_priced";
+    case Counter::Pushes:
+        return "pushes";
+    case Counter::Relabels:
+        return "relabels";
+    case Counter::Augmentations:
+        return "augmentations";
+    case Counter::HeapPushes:
+        return "heap_pushes";
+    case Counter::HeapPops:
+        return "heap_pops";
+    }
+    return "unknown";
+}
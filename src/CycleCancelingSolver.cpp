@@ -0,0 +1,506 @@
+/**
+ * @file CycleCancelingSolver.cpp
+ * @brief Implementation of the minimum mean cycle canceling solver
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ *
+ * Notation: arc a = (u, v) has scaled cost c[a] and flow x[a] >= 0. Its
+ * residual arcs are numbered 2a (forward u -> v, cost c[a], unlimited
+ * capacity) and 2a + 1 (backward v -> u, cost -c[a], capacity x[a]). A
+ * negative residual cycle always holds a backward arc, since the precheck
+ * rules out negative cycles of network arcs.
+ */
+
+#include "CycleCancelingSolver.hpp"
+#include "Counters.hpp"
+#include "NativeSolver.hpp"
+#include "Parallel.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+
+/// Policy iterations before Howard's algorithm may stop at a negative cycle
+constexpr int EARLY_ITERATIONS = 3;
+
+/// Policy iterations after which a component is left to the final check
+constexpr int MAX_ITERATIONS = 1000;
+
+constexpr size_t NONE = numeric_limits<size_t>::max();
+constexpr long long INF = numeric_limits<long long>::max();
+
+/**
+ * @brief Comparison slack for Howard's floating point cycle means
+ * @param value Magnitude of the compared values
+ * @return Tolerance; exactness is restored by the final certificate
+ */
+double tolerance(double value) { return 1e-9 * max(1.0, std::abs(value)); }
+
+/**
+ * @class CycleCanceling
+ * @brief State of one cycle canceling solve
+ */
+class CycleCanceling {
+private:
+    const FlowGraph &g;
+    const vector<long long> &c;
+
+    // Per-node state; components touch disjoint entries, so tasks share it
+    ArenaVector<int> comp;
+    ArenaVector<size_t> policy;
+    ArenaVector<double> lambda;
+    ArenaVector<double> dist;
+    ArenaVector<char> mark;
+
+    // Tarjan state, reused by every round
+    ArenaVector<int> index;
+    ArenaVector<int> low;
+    ArenaVector<int> stack;
+    ArenaVector<char> onStack;
+    ArenaVector<pair<int, size_t>> frames;
+
+    // Certificate state, reused by every round
+    ArenaVector<size_t> pred;
+    ArenaVector<int> seen;
+    NodeQueue queue;
+
+public:
+    vector<long long> x;
+    vector<long long> pi;
+
+    CycleCanceling(const IntegralInstance &inst, vector<long long> flow,
+                   vector<long long> potentials, SolveArena &memory)
+        : g(inst.graph), c(inst.cost),
+          comp(memory.vector<int>(inst.graph.numNodes)),
+          policy(memory.vector<size_t>(inst.graph.numNodes)),
+          lambda(memory.vector<double>(inst.graph.numNodes)),
+          dist(memory.vector<double>(inst.graph.numNodes)),
+          mark(memory.vector<char>(inst.graph.numNodes)),
+          index(memory.vector<int>(inst.graph.numNodes)),
+          low(memory.vector<int>(inst.graph.numNodes)), stack(memory.get()),
+          onStack(memory.vector<char>(inst.graph.numNodes, 0)),
+          frames(memory.get()),
+          pred(memory.vector<size_t>(inst.graph.numNodes)),
+          seen(memory.vector<int>(inst.graph.numNodes)),
+          queue(inst.graph.numNodes, memory), x(std::move(flow)),
+          pi(std::move(potentials)) {
+        // A loop only adds its cost
+        for (size_t a = 0; a < x.size(); ++a)
+            if (g.source[a] == g.target[a])
+                x[a] = 0;
+    }
+
+    int head(size_t r) const {
+        return r & 1 ? g.source[r >> 1] : g.target[r >> 1];
+    }
+
+    int tail(size_t r) const {
+        return r & 1 ? g.target[r >> 1] : g.source[r >> 1];
+    }
+
+    long long cost(size_t r) const {
+        return r & 1 ? -c[r >> 1] : c[r >> 1];
+    }
+
+    size_t degree(int v) const {
+        return g.outBegin[v + 1] - g.outBegin[v] + g.inBegin[v + 1] -
+               g.inBegin[v];
+    }
+
+    /**
+     * @brief Residual arc leaving a node
+     * @param v Node
+     * @param pos Position below degree(v), out arcs first
+     * @return Residual arc, or NONE if it has no capacity or is a loop
+     */
+    size_t residualAt(int v, size_t pos) const {
+        size_t out = g.outBegin[v + 1] - g.outBegin[v];
+        size_t a = pos < out ? g.outArcs[g.outBegin[v] + pos]
+                             : g.inArcs[g.inBegin[v] + pos - out];
+        if (g.source[a] == g.target[a])
+            return NONE;
+        if (pos < out)
+            return 2 * a;
+        return x[a] > 0 ? 2 * a + 1 : NONE;
+    }
+
+    /**
+     * @brief Label the strongly connected components of the residual graph
+     * @return Number of components
+     *
+     * Iterative Tarjan's algorithm.
+     */
+    int components() {
+        const int n = g.numNodes;
+        fill(index.begin(), index.end(), -1);
+        int counter = 0, count = 0;
+
+        auto open = [&](int v) {
+            index[v] = low[v] = counter++;
+            stack.push_back(v);
+            onStack[v] = 1;
+            frames.emplace_back(v, 0);
+        };
+
+        for (int root = 0; root < n; ++root) {
+            if (index[root] >= 0)
+                continue;
+            open(root);
+            while (!frames.empty()) {
+                int v = frames.back().first;
+                size_t &pos = frames.back().second;
+                bool descended = false;
+                while (pos < degree(v)) {
+                    size_t r = residualAt(v, pos++);
+                    if (r == NONE)
+                        continue;
+                    int w = head(r);
+                    if (index[w] < 0) {
+                        open(w);
+                        descended = true;
+                        break;
+                    }
+                    if (onStack[w])
+                        low[v] = min(low[v], index[w]);
+                }
+                if (descended)
+                    continue;
+
+                if (low[v] == index[v]) {
+                    int w;
+                    do {
+                        w = stack.back();
+                        stack.pop_back();
+                        onStack[w] = 0;
+                        comp[w] = count;
+                    } while (w != v);
+                    ++count;
+                }
+                frames.pop_back();
+                if (!frames.empty()) {
+                    int parent = frames.back().first;
+                    low[parent] = min(low[parent], low[v]);
+                }
+            }
+        }
+        return count;
+    }
+
+    /**
+     * @brief Compute cycle means and distances of the current policy
+     * @param nodes Nodes of one component
+     * @param cycles Receives the policy cycles of negative cost
+     *
+     * Every node's policy arc leads to exactly one cycle; the node takes
+     * that cycle's mean and its distance to it, measured with costs reduced
+     * by the mean.
+     */
+    void evaluate(const vector<int> &nodes, vector<vector<size_t>> &cycles) {
+        for (int v : nodes)
+            mark[v] = 0;
+
+        vector<int> path;
+        for (int start : nodes) {
+            if (mark[start])
+                continue;
+            path.clear();
+            int v = start;
+            while (mark[v] == 0) {
+                mark[v] = 1;
+                path.push_back(v);
+                v = head(policy[v]);
+            }
+
+            size_t keep = path.size();
+            if (mark[v] == 1) {
+                // The path closes a new cycle through v
+                size_t k = path.size() - 1;
+                while (path[k] != v)
+                    --k;
+                long long total = 0;
+                for (size_t j = k; j < path.size(); ++j)
+                    total += cost(policy[path[j]]);
+                double mean =
+                    static_cast<double>(total) / (path.size() - k);
+
+                lambda[v] = mean;
+                dist[v] = 0.0;
+                mark[v] = 2;
+                for (size_t j = path.size() - 1; j > k; --j) {
+                    int u = path[j];
+                    lambda[u] = mean;
+                    dist[u] = cost(policy[u]) - mean + dist[head(policy[u])];
+                    mark[u] = 2;
+                }
+                if (total < 0) {
+                    vector<size_t> cycle;
+                    for (size_t j = k; j < path.size(); ++j)
+                        cycle.push_back(policy[path[j]]);
+                    cycles.push_back(std::move(cycle));
+                }
+                keep = k;
+            }
+
+            for (size_t j = keep; j-- > 0;) {
+                int u = path[j];
+                int w = head(policy[u]);
+                lambda[u] = lambda[w];
+                dist[u] = cost(policy[u]) - lambda[u] + dist[w];
+                mark[u] = 2;
+            }
+        }
+    }
+
+    /**
+     * @brief Improve the policy of one component
+     * @param nodes Nodes of the component
+     * @param id Component id
+     * @return False if the policy is optimal
+     *
+     * Nodes first switch to arcs reaching a cycle of smaller mean; only if
+     * none can, they switch to arcs that shorten their distance.
+     */
+    bool improve(const vector<int> &nodes, int id) {
+        bool changed = false;
+        for (int v : nodes) {
+            double best = lambda[v];
+            size_t choice = NONE;
+            for (size_t pos = 0; pos < degree(v); ++pos) {
+                size_t r = residualAt(v, pos);
+                if (r == NONE || comp[head(r)] != id)
+                    continue;
+                if (lambda[head(r)] < best - tolerance(best)) {
+                    best = lambda[head(r)];
+                    choice = r;
+                }
+            }
+            if (choice != NONE) {
+                policy[v] = choice;
+                changed = true;
+            }
+        }
+        if (changed)
+            return true;
+
+        for (int v : nodes) {
+            double best = dist[v];
+            size_t choice = NONE;
+            for (size_t pos = 0; pos < degree(v); ++pos) {
+                size_t r = residualAt(v, pos);
+                if (r == NONE || comp[head(r)] != id)
+                    continue;
+                int w = head(r);
+                if (std::abs(lambda[w] - lambda[v]) > tolerance(lambda[v]))
+                    continue;
+                double d = dist[w] + cost(r) - lambda[v];
+                if (d < best - tolerance(best)) {
+                    best = d;
+                    choice = r;
+                }
+            }
+            if (choice != NONE) {
+                policy[v] = choice;
+                changed = true;
+            }
+        }
+        return changed;
+    }
+
+    /**
+     * @brief Howard's minimum mean cycle algorithm on one component
+     * @param nodes Nodes of the component, at least two
+     * @param id Component id
+     * @return Node-disjoint negative cycles of the final policy
+     *
+     * Stops early once the policy holds a negative cycle after a few
+     * iterations; the exact minimum mean is not needed to make progress.
+     */
+    vector<vector<size_t>> howard(const vector<int> &nodes, int id) {
+        for (int v : nodes) {
+            long long best = INF;
+            for (size_t pos = 0; pos < degree(v); ++pos) {
+                size_t r = residualAt(v, pos);
+                if (r != NONE && comp[head(r)] == id && cost(r) < best) {
+                    best = cost(r);
+                    policy[v] = r;
+                }
+            }
+        }
+
+        vector<vector<size_t>> cycles;
+        for (int iter = 0; iter < MAX_ITERATIONS; ++iter) {
+            cycles.clear();
+            evaluate(nodes, cycles);
+            if (!improve(nodes, id))
+                break;
+            if (!cycles.empty() && iter + 1 >= EARLY_ITERATIONS)
+                break;
+        }
+        return cycles;
+    }
+
+    /**
+     * @brief Send flow around a residual cycle
+     * @param cycle Residual arcs of the cycle
+     * @return False if the cycle has no backward arc with flow
+     */
+    bool cancel(const vector<size_t> &cycle) {
+        long long amount = INF;
+        for (size_t r : cycle)
+            if (r & 1)
+                amount = min(amount, x[r >> 1]);
+        if (amount == INF || amount == 0)
+            return false;
+        for (size_t r : cycle)
+            x[r >> 1] += r & 1 ? -amount : amount;
+        EventCounters::add(Counter::Augmentations);
+        return true;
+    }
+
+    /**
+     * @brief Compute potentials certifying optimality
+     * @return Empty on success, otherwise a negative residual cycle
+     *
+     * Label-correcting shortest paths on the residual graph, starting from
+     * the current potentials. After every n relaxations the predecessor
+     * graph is checked for a cycle, which then has negative cost.
+     */
+    vector<size_t> certify() {
+        const int n = g.numNodes;
+        fill(pred.begin(), pred.end(), NONE);
+        queue.clear();
+        for (int v = 0; v < n; ++v)
+            queue.push(v);
+
+        auto predecessorCycle = [&]() -> vector<size_t> {
+            fill(seen.begin(), seen.end(), 0);
+            for (int s = 0; s < n; ++s) {
+                int v = s;
+                while (seen[v] == 0 && pred[v] != NONE) {
+                    seen[v] = s + 1;
+                    v = tail(pred[v]);
+                }
+                if (seen[v] != s + 1)
+                    continue;
+                vector<size_t> cycle;
+                int u = v;
+                do {
+                    cycle.push_back(pred[u]);
+                    u = tail(pred[u]);
+                } while (u != v);
+                return cycle;
+            }
+            return {};
+        };
+
+        size_t relaxations = 0;
+        while (!queue.empty()) {
+            int u = queue.pop();
+            for (size_t pos = 0; pos < degree(u); ++pos) {
+                size_t r = residualAt(u, pos);
+                if (r == NONE)
+                    continue;
+                int w = head(r);
+                if (pi[u] + cost(r) >= pi[w])
+                    continue;
+                pi[w] = pi[u] + cost(r);
+                pred[w] = r;
+                EventCounters::add(Counter::Relabels);
+                queue.push(w);
+                if (++relaxations % n == 0) {
+                    vector<size_t> cycle = predecessorCycle();
+                    if (!cycle.empty())
+                        return cycle;
+                }
+            }
+        }
+        return {};
+    }
+
+    /**
+     * @brief Cancel negative cycles until the flow is optimal
+     * @param threads Worker threads for the component searches
+     * @throws std::logic_error If a negative cycle cannot carry flow
+     */
+    void run(unsigned threads) {
+        const int n = g.numNodes;
+        while (true) {
+            int count = components();
+
+            // Group nodes by component, largest components first
+            vector<vector<int>> members(count);
+            for (int v = 0; v < n; ++v)
+                members[comp[v]].push_back(v);
+            sort(members.begin(), members.end(),
+                 [](const vector<int> &a, const vector<int> &b) {
+                     return a.size() > b.size();
+                 });
+            size_t tasks = 0;
+            while (tasks < members.size() && members[tasks].size() > 1)
+                ++tasks;
+
+            atomic<bool> canceled(false);
+            parallelTasks(tasks, threads, [&](size_t task) {
+                const vector<int> &nodes = members[task];
+                for (const vector<size_t> &cycle :
+                     howard(nodes, comp[nodes.front()]))
+                    if (cancel(cycle))
+                        canceled.store(true, memory_order_relaxed);
+            });
+            if (canceled.load())
+                continue;
+
+            vector<size_t> cycle = certify();
+            if (cycle.empty())
+                return;
+            if (!cancel(cycle))
+                throw std::logic_error(
+                    "Negative residual cycle without flow to cancel");
+        }
+    }
+};
+
+} // namespace
+
+/**
+ * @brief Construct a solver for a network
+ * @param network Network to solve, must outlive the solver
+ */
+CycleCancelingSolver::CycleCancelingSolver(const NetworkFlow &network)
+    : net(network) {}
+
+/**
+ * @brief Solve the network
+ * @param options Solve options (threads, initial flow, potentials)
+ * @return Solution with flows and optimal potentials
+ * @throws std::invalid_argument If the initial flow is not feasible
+ *
+ * Returns status "Infeasible" or "Unbounded" without flows when the network
+ * has no optimal solution, and explains why if the data cannot be scaled to
+ * integers. Warm-start potentials only seed the final certificate.
+ */
+Solution CycleCancelingSolver::solve(const SolveOptions &options) const {
+    Solution result;
+    IntegralInstance inst(net, options.threads, options.nodeOrder);
+    if (!nativePrecheck(net, inst, result, options.threads))
+        return result;
+    TraceScope trace("cycle canceling", "engine");
+
+    vector<long long> flow = scaledFlows(options, inst);
+    if (flow.empty() && !feasibleFlow(inst, flow)) {
+        result.status = "Infeasible";
+        return result;
+    }
+
+    SolveArena arena(arenaBytes(inst));
+    CycleCanceling canceling(inst, std::move(flow),
+                             scaledPotentials(options, inst), arena);
+    canceling.run(options.threads);
+    return nativeSolution(net, inst, canceling.x, canceling.pi);
+}
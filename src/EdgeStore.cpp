@@ -0,0 +1,263 @@
+/**
+ * @file EdgeStore.cpp
+ * @brief Implementation of the on-disk edge store
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ *
+ * File format (native byte order): a 64 KiB header page holding "NFEDGSTR",
+ * uint32 version, uint32 edges per block, uint64 edge count and int32
+ * lowest and highest node index, followed by the blocks. Block b starts at
+ * HEADER_BYTES + b * BLOCK_BYTES and holds EDGE_BLOCK int32 sources,
+ * EDGE_BLOCK int32 targets and EDGE_BLOCK double costs; the last block is
+ * padded. Block boundaries are page aligned for page sizes up to 64 KiB.
+ */
+
+#include "EdgeStore.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+
+constexpr char MAGIC[8] = {'N', 'F', 'E', 'D', 'G', 'S', 'T', 'R'};
+constexpr uint32_t VERSION = 1;
+constexpr size_t HEADER_BYTES = size_t(1) << 16;
+constexpr size_t BLOCK_BYTES =
+    EDGE_BLOCK * (2 * sizeof(int32_t) + sizeof(double));
+static_assert(sizeof(int) == sizeof(int32_t),
+              "Edge store columns are read as int arrays");
+
+/**
+ * @struct StoreHeader
+ * @brief Fixed fields at the start of a store file
+ */
+struct StoreHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t blockEdges;
+    uint64_t count;
+    int32_t minNode;
+    int32_t maxNode;
+};
+
+/**
+ * @brief Write a whole buffer at a file offset
+ * @throws std::runtime_error If the write fails
+ */
+void writeAt(int fd, const void *data, size_t bytes, size_t offset,
+             const string &path) {
+    const char *p = static_cast<const char *>(data);
+    while (bytes > 0) {
+        ssize_t done = ::pwrite(fd, p, bytes, static_cast<off_t>(offset));
+        if (done < 0 && errno == EINTR)
+            continue;
+        if (done <= 0)
+            throw std::runtime_error("Failed to write edge store: " + path);
+        p += done;
+        bytes -= static_cast<size_t>(done);
+        offset += static_cast<size_t>(done);
+    }
+}
+
+/// Number of blocks holding count edges
+size_t blockCount(size_t count) {
+    return (count + EDGE_BLOCK - 1) / EDGE_BLOCK;
+}
+
+} // namespace
+
+/**
+ * @brief Create or truncate a store file
+ * @param filePath File to write
+ * @throws std::runtime_error If the file cannot be created
+ */
+EdgeStoreWriter::EdgeStoreWriter(const string &filePath)
+    : path(filePath), fd(-1), count(0), minNode(INT_MAX), maxNode(0) {
+    fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        throw std::runtime_error("Cannot create edge store: " + path);
+    from.reserve(EDGE_BLOCK);
+    to.reserve(EDGE_BLOCK);
+    cost.reserve(EDGE_BLOCK);
+}
+
+EdgeStoreWriter::~EdgeStoreWriter() {
+    if (fd >= 0)
+        ::close(fd);
+}
+
+/**
+ * @brief Write the buffered block, padded to full size
+ */
+void EdgeStoreWriter::flush() {
+    if (from.empty())
+        return;
+    size_t filled = from.size();
+    from.resize(EDGE_BLOCK, 0);
+    to.resize(EDGE_BLOCK, 0);
+    cost.resize(EDGE_BLOCK, 0.0);
+
+    size_t offset =
+        HEADER_BYTES + (count - filled) / EDGE_BLOCK * BLOCK_BYTES;
+    writeAt(fd, from.data(), EDGE_BLOCK * sizeof(int32_t), offset, path);
+    offset += EDGE_BLOCK * sizeof(int32_t);
+    writeAt(fd, to.data(), EDGE_BLOCK * sizeof(int32_t), offset, path);
+    offset += EDGE_BLOCK * sizeof(int32_t);
+    writeAt(fd, cost.data(), EDGE_BLOCK * sizeof(double), offset, path);
+
+    from.clear();
+    to.clear();
+    cost.clear();
+}
+
+/**
+ * @brief Append edges stored as parallel arrays
+ * @param f Source node indices (1-indexed)
+ * @param t Destination node indices (1-indexed)
+ * @param c Costs per unit of flow
+ * @param n Number of edges in the arrays
+ * @throws std::runtime_error If writing fails
+ */
+void EdgeStoreWriter::append(const int *f, const int *t, const double *c,
+                             size_t n) {
+    if (fd < 0)
+        throw std::logic_error("Edge store already finished: " + path);
+    for (size_t i = 0; i < n; ++i) {
+        minNode = std::min(minNode, std::min(f[i], t[i]));
+        maxNode = std::max(maxNode, std::max(f[i], t[i]));
+        from.push_back(f[i]);
+        to.push_back(t[i]);
+        cost.push_back(c[i]);
+        ++count;
+        if (from.size() == EDGE_BLOCK)
+            flush();
+    }
+}
+
+/**
+ * @brief Write the last block and the header, then close the file
+ * @throws std::runtime_error If writing fails
+ */
+void EdgeStoreWriter::finish() {
+    if (fd < 0)
+        throw std::logic_error("Edge store already finished: " + path);
+    flush();
+
+    StoreHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.blockEdges = static_cast<uint32_t>(EDGE_BLOCK);
+    header.count = count;
+    header.minNode = count > 0 ? minNode : 0;
+    header.maxNode = maxNode;
+    writeAt(fd, &header, sizeof(header), 0, path);
+
+    // Size the file explicitly so an empty store still has its header page
+    size_t size = HEADER_BYTES + blockCount(count) * BLOCK_BYTES;
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0)
+        throw std::runtime_error("Failed to write edge store: " + path);
+
+    int f = fd;
+    fd = -1;
+    if (::close(f) != 0)
+        throw std::runtime_error("Failed to close edge store: " + path);
+}
+
+/**
+ * @brief Map a store written by EdgeStoreWriter
+ * @param filePath File to read
+ * @param memoryBudget Bytes of the file a sweep may keep resident
+ * @throws std::runtime_error If the file cannot be read or is invalid
+ */
+EdgeStore::EdgeStore(const string &filePath, size_t memoryBudget)
+    : path(filePath), data(nullptr), length(0), count(0), minNode(0),
+      maxNode(0), budget(memoryBudget) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("Cannot open edge store: " + path);
+
+    struct stat st;
+    StoreHeader header;
+    bool valid =
+        ::fstat(fd, &st) == 0 &&
+        ::pread(fd, &header, sizeof(header), 0) ==
+            static_cast<ssize_t>(sizeof(header)) &&
+        std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 &&
+        header.version == VERSION && header.blockEdges == EDGE_BLOCK &&
+        header.count <= (SIZE_MAX - HEADER_BYTES) / BLOCK_BYTES * EDGE_BLOCK &&
+        static_cast<size_t>(st.st_size) >=
+            HEADER_BYTES + blockCount(header.count) * BLOCK_BYTES;
+    if (!valid) {
+        ::close(fd);
+        throw std::runtime_error("Invalid edge store: " + path);
+    }
+    count = header.count;
+    minNode = header.minNode;
+    maxNode = header.maxNode;
+
+    if (count > 0) {
+        length = HEADER_BYTES + blockCount(count) * BLOCK_BYTES;
+        void *p = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("Cannot map edge store: " + path);
+        }
+        ::madvise(p, length, MADV_SEQUENTIAL);
+        data = static_cast<const char *>(p);
+    }
+    ::close(fd);
+}
+
+EdgeStore::~EdgeStore() {
+    if (data)
+        ::munmap(const_cast<char *>(data), length);
+}
+
+/**
+ * @brief Visit all edges block by block
+ * @param fn Callback receiving each block once
+ * @param threads Worker threads, 0 for hardware concurrency
+ */
+void EdgeStore::sweep(const EdgeSweep &fn, unsigned threads) const {
+    const size_t blocks = blockCount(count);
+    const size_t window = std::max<size_t>(budget / 2 / BLOCK_BYTES, 1);
+    auto advise = [&](size_t first, size_t last, int advice) {
+        ::madvise(const_cast<char *>(data) + HEADER_BYTES +
+                      first * BLOCK_BYTES,
+                  (last - first) * BLOCK_BYTES, advice);
+    };
+
+    for (size_t w = 0; w < blocks; w += window) {
+        const size_t last = std::min(blocks, w + window);
+        if (last < blocks)
+            advise(last, std::min(blocks, last + window), MADV_WILLNEED);
+
+        parallelTasks(last - w, threads, [&](size_t i) {
+            const size_t b = w + i;
+            const char *p = data + HEADER_BYTES + b * BLOCK_BYTES;
+            EdgeBlock block;
+            block.first = b * EDGE_BLOCK;
+            block.count = std::min(EDGE_BLOCK, count - block.first);
+            block.from = reinterpret_cast<const int *>(p);
+            block.to = reinterpret_cast<const int *>(
+                p + EDGE_BLOCK * sizeof(int32_t));
+            block.cost = reinterpret_cast<const double *>(
+                p + 2 * EDGE_BLOCK * sizeof(int32_t));
+            fn(block);
+        });
+
+        // Clean file pages are dropped and reread if a later sweep needs them
+        advise(w, last, MADV_DONTNEED);
+    }
+}
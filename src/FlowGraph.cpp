@@ -0,0 +1,184 @@
+/**
+ * @file FlowGraph.cpp
+ * @brief Construction of the CSR graph view
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ */
+
+#include "FlowGraph.hpp"
+#include "Parallel.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+using namespace std;
+
+namespace {
+
+/// Edges per thread below which CSR construction stays single-threaded
+constexpr size_t MIN_PARALLEL_ARCS = size_t(1) << 16;
+
+/**
+ * @brief Turn per-node counters into CSR offsets
+ * @param counts Per-node counters, reset to the start offset of each node
+ * @param begin Receives n + 1 offsets
+ */
+void prefixSum(atomic<size_t> *counts, size_t n, vector<size_t> &begin) {
+    begin.assign(n + 1, 0);
+    for (size_t v = 0; v < n; ++v) {
+        begin[v + 1] = begin[v] + counts[v].load(memory_order_relaxed);
+        counts[v].store(begin[v], memory_order_relaxed);
+    }
+}
+
+/**
+ * @class TopologyHasher
+ * @brief Incremental FNV-1a hash over 64-bit values
+ */
+class TopologyHasher {
+private:
+    uint64_t hash = 1469598103934665603ULL;
+
+public:
+    void mix(uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            hash ^= (value >> (8 * i)) & 0xff;
+            hash *= 1099511628211ULL;
+        }
+    }
+
+    uint64_t value() const { return hash; }
+};
+
+} // namespace
+
+/**
+ * @brief Build the CSR view of a network
+ * @param net Source network
+ * @param threads Worker threads, 0 for hardware concurrency
+ */
+FlowGraph::FlowGraph(const NetworkFlow &net, unsigned threads)
+    : numNodes(net.getNumNodes()) {
+    TraceScope trace("build graph");
+    const size_t m = net.getNumEdges();
+    source.resize(m);
+    target.resize(m);
+    cost.resize(m);
+
+    // Copy arcs into SoA form
+    net.sweepEdges(
+        [&](const EdgeBlock &block) {
+            for (size_t i = 0; i < block.count; ++i) {
+                size_t a = block.first + i;
+                source[a] = block.from[i] - 1;
+                target[a] = block.to[i] - 1;
+                cost[a] = block.cost[i];
+            }
+        },
+        threads);
+
+    buildAdjacency(threads);
+}
+
+/**
+ * @brief Build the CSR view of arcs given as arrays
+ * @param n Number of nodes
+ * @param arcSource Tail of each arc (0-indexed)
+ * @param arcTarget Head of each arc (0-indexed)
+ * @param arcCost Cost of each arc
+ * @param threads Worker threads, 0 for hardware concurrency
+ */
+FlowGraph::FlowGraph(int n, vector<int> arcSource, vector<int> arcTarget,
+                     vector<double> arcCost, unsigned threads)
+    : numNodes(n), source(std::move(arcSource)), target(std::move(arcTarget)),
+      cost(std::move(arcCost)) {
+    buildAdjacency(threads);
+}
+
+/**
+ * @brief Fill the adjacency arrays from the arc arrays
+ * @param threads Worker threads, 0 for hardware concurrency
+ */
+void FlowGraph::buildAdjacency(unsigned threads) {
+    const size_t m = source.size();
+    const size_t n = static_cast<size_t>(numNodes);
+    outArcs.resize(m);
+    inArcs.resize(m);
+
+    unique_ptr<atomic<size_t>[]> outFill(new atomic<size_t>[n]);
+    unique_ptr<atomic<size_t>[]> inFill(new atomic<size_t>[n]);
+    for (size_t v = 0; v < n; ++v) {
+        outFill[v].store(0, memory_order_relaxed);
+        inFill[v].store(0, memory_order_relaxed);
+    }
+
+    // Count degrees
+    parallelChunks(m, MIN_PARALLEL_ARCS, threads,
+                   [&](size_t, size_t begin, size_t end) {
+                       for (size_t a = begin; a < end; ++a) {
+                           outFill[source[a]].fetch_add(
+                               1, memory_order_relaxed);
+                           inFill[target[a]].fetch_add(
+                               1, memory_order_relaxed);
+                       }
+                   });
+
+    prefixSum(outFill.get(), n, outBegin);
+    prefixSum(inFill.get(), n, inBegin);
+
+    // Scatter arcs into their adjacency slots
+    parallelChunks(m, MIN_PARALLEL_ARCS, threads,
+                   [&](size_t, size_t begin, size_t end) {
+                       for (size_t a = begin; a < end; ++a) {
+                           outArcs[outFill[source[a]].fetch_add(
+                               1, memory_order_relaxed)] = a;
+                           inArcs[inFill[target[a]].fetch_add(
+                               1, memory_order_relaxed)] = a;
+                       }
+                   });
+
+    // Make the layout independent of thread interleaving
+    parallelChunks(n, MIN_PARALLEL_ARCS / 8, threads,
+                   [&](size_t, size_t begin, size_t end) {
+                       for (size_t v = begin; v < end; ++v) {
+                           sort(outArcs.begin() + outBegin[v],
+                                outArcs.begin() + outBegin[v + 1]);
+                           sort(inArcs.begin() + inBegin[v],
+                                inArcs.begin() + inBegin[v + 1]);
+                       }
+                   });
+}
+
+/**
+ * @brief Fingerprint of a graph's topology
+ * @param g Graph to hash
+ * @return 64-bit FNV-1a hash of the node count and the arc endpoints
+ */
+uint64_t topologyHash(const FlowGraph &g) {
+    TopologyHasher hash;
+    hash.mix(static_cast<uint64_t>(g.numNodes));
+    for (size_t a = 0; a < g.numArcs(); ++a) {
+        hash.mix(static_cast<uint64_t>(g.source[a]));
+        hash.mix(static_cast<uint64_t>(g.target[a]));
+    }
+    return hash.value();
+}
+
+/**
+ * @brief Fingerprint of a network's topology
+ * @param net Network to hash
+ * @return Same value as topologyHash(FlowGraph(net)), computed in one
+ *         sequential sweep over the edges without building the graph
+ */
+uint64_t topologyHash(const NetworkFlow &net) {
+    TopologyHasher hash;
+    hash.mix(static_cast<uint64_t>(net.getNumNodes()));
+    net.sweepEdges([&](const EdgeBlock &block) {
+        for (size_t i = 0; i < block.count; ++i) {
+            hash.mix(static_cast<uint64_t>(block.from[i] - 1));
+            hash.mix(static_cast<uint64_t>(block.to[i] - 1));
+        }
+    });
+    return hash.value();
+}
@@ -0,0 +1,215 @@
+/**
+ * @file GraphOrder.cpp
+ * @brief Implementation of the node orderings
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ */
+
+#include "GraphOrder.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+using namespace std;
+
+namespace {
+
+/// Rounds of the pseudo-peripheral node search per component
+constexpr int PERIPHERAL_ROUNDS = 8;
+
+/**
+ * @class UndirectedView
+ * @brief Neighbours and degrees of a FlowGraph ignoring arc directions
+ */
+class UndirectedView {
+private:
+    const FlowGraph &g;
+
+public:
+    explicit UndirectedView(const FlowGraph &graph) : g(graph) {}
+
+    size_t degree(int v) const {
+        return g.outBegin[v + 1] - g.outBegin[v] + g.inBegin[v + 1] -
+               g.inBegin[v];
+    }
+
+    /// Call fn(w) for every arc joining v to another node w
+    template <typename F> void forEachNeighbour(int v, F &&fn) const {
+        for (size_t i = g.outBegin[v]; i < g.outBegin[v + 1]; ++i)
+            if (g.target[g.outArcs[i]] != v)
+                fn(g.target[g.outArcs[i]]);
+        for (size_t i = g.inBegin[v]; i < g.inBegin[v + 1]; ++i)
+            if (g.source[g.inArcs[i]] != v)
+                fn(g.source[g.inArcs[i]]);
+    }
+};
+
+/**
+ * @brief Breadth-first search over nodes not marked yet
+ * @param view Undirected topology
+ * @param start First node, unmarked
+ * @param mark Nodes reached are set to true
+ * @param visited Receives the reached nodes in visiting order
+ * @param byDegree Visit the new neighbours of each node by increasing degree
+ * @param lastLevel Receives the position in visited of the first node of
+ *        the last level
+ * @return Number of levels
+ */
+int breadthFirst(const UndirectedView &view, int start, vector<char> &mark,
+                 vector<int> &visited, bool byDegree, size_t &lastLevel) {
+    visited.assign(1, start);
+    mark[start] = 1;
+    lastLevel = 0;
+    int levels = 0;
+    for (size_t i = 0; i < visited.size(); ++levels) {
+        const size_t levelEnd = visited.size();
+        for (; i < levelEnd; ++i) {
+            const size_t first = visited.size();
+            view.forEachNeighbour(visited[i], [&](int w) {
+                if (!mark[w]) {
+                    mark[w] = 1;
+                    visited.push_back(w);
+                }
+            });
+            if (byDegree)
+                stable_sort(visited.begin() + first, visited.end(),
+                            [&](int a, int b) {
+                                return view.degree(a) < view.degree(b);
+                            });
+        }
+        if (visited.size() > levelEnd)
+            lastLevel = levelEnd;
+    }
+    return levels;
+}
+
+/**
+ * @brief Find a node of nearly maximal eccentricity in a component
+ * @param view Undirected topology
+ * @param start Any node of the component, unmarked
+ * @param mark Marks of earlier components; left unchanged
+ * @return Pseudo-peripheral node (George-Liu)
+ *
+ * Repeatedly moves to the smallest degree node of the last breadth-first
+ * level while that makes the search deeper.
+ */
+int peripheralNode(const UndirectedView &view, int start, vector<char> &mark) {
+    vector<int> visited;
+    int node = start;
+    int depth = 0;
+    for (int round = 0; round < PERIPHERAL_ROUNDS; ++round) {
+        size_t lastLevel;
+        int levels = breadthFirst(view, node, mark, visited, false, lastLevel);
+        for (int v : visited)
+            mark[v] = 0;
+        if (levels <= depth)
+            break;
+        depth = levels;
+        int best = *min_element(visited.begin() + lastLevel, visited.end(),
+                                [&](int a, int b) {
+                                    return view.degree(a) < view.degree(b);
+                                });
+        if (best == node)
+            break;
+        node = best;
+    }
+    return node;
+}
+
+} // namespace
+
+/**
+ * @brief Compute a node numbering
+ * @param g Graph whose undirected topology is ordered
+ * @param order Ordering strategy
+ * @return Old node id at each new position, or an empty vector for
+ *         NodeOrder::Original
+ */
+vector<int> nodeOrdering(const FlowGraph &g, NodeOrder order) {
+    if (order == NodeOrder::Original)
+        return {};
+
+    const UndirectedView view(g);
+    vector<int> nodes(g.numNodes);
+    iota(nodes.begin(), nodes.end(), 0);
+
+    if (order == NodeOrder::DegreeSorted) {
+        stable_sort(nodes.begin(), nodes.end(), [&](int a, int b) {
+            return view.degree(a) > view.degree(b);
+        });
+        return nodes;
+    }
+
+    // Components are started from their smallest degree nodes
+    stable_sort(nodes.begin(), nodes.end(), [&](int a, int b) {
+        return view.degree(a) < view.degree(b);
+    });
+    vector<char> mark(g.numNodes, 0);
+    vector<int> result, visited;
+    result.reserve(g.numNodes);
+    for (int seed : nodes) {
+        if (mark[seed])
+            continue;
+        size_t lastLevel;
+        int start = peripheralNode(view, seed, mark);
+        breadthFirst(view, start, mark, visited,
+                     order == NodeOrder::ReverseCuthillMcKee, lastLevel);
+        result.insert(result.end(), visited.begin(), visited.end());
+    }
+    if (order == NodeOrder::ReverseCuthillMcKee)
+        reverse(result.begin(), result.end());
+    return result;
+}
+
+/**
+ * @brief Renumber the nodes of a graph
+ * @param g Graph to renumber
+ * @param order Old node id at each new position, from nodeOrdering()
+ * @param arcOrder Receives the old arc index of each new arc
+ * @param threads Worker threads, 0 for hardware concurrency
+ * @return Renumbered graph with arcs sorted by new source, then new target
+ *
+ * Parallel arcs keep their relative order, so the result does not depend
+ * on scheduling.
+ */
+FlowGraph renumberGraph(const FlowGraph &g, const vector<int> &order,
+                        vector<size_t> &arcOrder, unsigned threads) {
+    const size_t n = static_cast<size_t>(g.numNodes);
+    const size_t m = g.numArcs();
+    vector<int> newId(n);
+    for (size_t k = 0; k < n; ++k)
+        newId[order[k]] = static_cast<int>(k);
+
+    // New arc position of the first arc of each new source
+    vector<size_t> begin(n + 1, 0);
+    for (size_t k = 0; k < n; ++k)
+        begin[k + 1] = begin[k] + g.outBegin[order[k] + 1] -
+                       g.outBegin[order[k]];
+
+    arcOrder.resize(m);
+    vector<int> source(m), target(m);
+    vector<double> cost(m);
+    parallelChunks(n, size_t(1) << 12, threads,
+                   [&](size_t, size_t first, size_t last) {
+                       for (size_t k = first; k < last; ++k) {
+                           const int v = order[k];
+                           auto out = arcOrder.begin() + begin[k];
+                           copy(g.outArcs.begin() + g.outBegin[v],
+                                g.outArcs.begin() + g.outBegin[v + 1], out);
+                           stable_sort(out, arcOrder.begin() + begin[k + 1],
+                                       [&](size_t a, size_t b) {
+                                           return newId[g.target[a]] <
+                                                  newId[g.target[b]];
+                                       });
+                           for (size_t i = begin[k]; i < begin[k + 1]; ++i) {
+                               source[i] = static_cast<int>(k);
+                               target[i] = newId[g.target[arcOrder[i]]];
+                               cost[i] = g.cost[arcOrder[i]];
+                           }
+                       }
+                   });
+
+    return FlowGraph(g.numNodes, std::move(source), std::move(target),
+                     std::move(cost), threads);
+}
@@ -0,0 +1,506 @@
+/**
+ * @file InstanceReader.cpp
+ * @brief Implementation of the parallel instance readers
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ */
+
+#include "InstanceReader.hpp"
+#include "Parallel.hpp"
+#include "Trace.hpp"
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <fcntl.h>
+#include <memory>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+/**
+ * @class MappedFile
+ * @brief Read-only memory mapping of a whole file
+ */
+class MappedFile {
+private:
+    const char *data;
+    size_t length;
+
+public:
+    explicit MappedFile(const string &path) : data(nullptr), length(0) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("Cannot open instance file: " + path);
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Cannot stat instance file: " + path);
+        }
+        length = static_cast<size_t>(st.st_size);
+
+        if (length > 0) {
+            void *p = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Cannot map instance file: " + path);
+            }
+            ::madvise(p, length, MADV_SEQUENTIAL);
+            data = static_cast<const char *>(p);
+        }
+        ::close(fd);
+    }
+
+    ~MappedFile() {
+        if (data)
+            ::munmap(const_cast<char *>(data), length);
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    const char *begin() const { return data; }
+    const char *end() const { return data + length; }
+    size_t size() const { return length; }
+
+    /**
+     * @brief Ask the kernel to read a byte range ahead
+     * @param first Offset of the first byte
+     * @param last Offset one past the last byte
+     */
+    void prefetch(size_t first, size_t last) const {
+        static const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        const size_t aligned = first / page * page;
+        if (last > aligned)
+            ::madvise(const_cast<char *>(data) + aligned, last - aligned,
+                      MADV_WILLNEED);
+    }
+};
+
+/**
+ * @brief Find the next newline in [p, end)
+ * @return Pointer to the newline, or end if there is none
+ *
+ * Scans 16 bytes per step with SSE2 where available.
+ */
+const char *findNewline(const char *p, const char *end) {
+#if defined(__SSE2__)
+    const __m128i nl = _mm_set1_epi8('\n');
+    while (end - p >= 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, nl));
+        if (mask != 0)
+            return p + __builtin_ctz(static_cast<unsigned>(mask));
+        p += 16;
+    }
+#endif
+    const void *hit = memchr(p, '\n', static_cast<size_t>(end - p));
+    return hit ? static_cast<const char *>(hit) : end;
+}
+
+/**
+ * @class LineParser
+ * @brief Field cursor over a single line of text
+ */
+class LineParser {
+private:
+    const char *p;
+    const char *end;
+
+public:
+    LineParser(const char *b, const char *e) : p(b), end(e) {}
+
+    void skipBlanks() {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+            ++p;
+    }
+
+    bool atEnd() {
+        skipBlanks();
+        return p == end;
+    }
+
+    char peek() {
+        skipBlanks();
+        return p < end ? *p : '\0';
+    }
+
+    bool skip(char c) {
+        skipBlanks();
+        if (p < end && *p == c) {
+            ++p;
+            return true;
+        }
+        return false;
+    }
+
+    template <typename T> bool read(T &value) {
+        skipBlanks();
+        auto res = std::from_chars(p, end, value);
+        if (res.ec != std::errc())
+            return false;
+        p = res.ptr;
+        return true;
+    }
+};
+
+/**
+ * @struct ChunkBuffers
+ * @brief Thread-local structure-of-arrays output of one parsed chunk
+ */
+struct ChunkBuffers {
+    vector<int> from;
+    vector<int> to;
+    vector<double> cost;
+    vector<int> nodeIds;
+    vector<double> supplies;
+    size_t lines = 0;
+    size_t problemLines = 0;
+    int maxNode = 0;
+    double minCapacity = std::numeric_limits<double>::infinity();
+    size_t minCapacityLine = 0; ///< Chunk-local line of minCapacity
+    size_t errorLine = 0; ///< Chunk-local line of the first error, 0 if none
+    string error;
+
+    void fail(const string &message) {
+        errorLine = lines;
+        error = message;
+    }
+};
+
+/**
+ * @struct ProblemLine
+ * @brief Contents of the DIMACS "p min <nodes> <arcs>" line
+ */
+struct ProblemLine {
+    int nodes = 0;
+    size_t arcs = 0;
+};
+
+/**
+ * @brief Locate and parse the DIMACS problem line
+ * @throws std::runtime_error If it is missing or malformed
+ */
+ProblemLine readProblemLine(const MappedFile &file) {
+    size_t line = 0;
+    for (const char *p = file.begin(); p < file.end();) {
+        const char *eol = findNewline(p, file.end());
+        ++line;
+        LineParser lp(p, eol);
+        if (lp.skip('p')) {
+            ProblemLine prob;
+            lp.skipBlanks();
+            if (!lp.skip('m') || !lp.skip('i') || !lp.skip('n') ||
+                !lp.read(prob.nodes) || !lp.read(prob.arcs) || !lp.atEnd() ||
+                prob.nodes < 1)
+                throw std::runtime_error("Malformed problem line at line " +
+                                         to_string(line));
+            return prob;
+        }
+        char c = lp.peek();
+        if (c != 'c' && c != '\0')
+            break;
+        p = eol + 1;
+    }
+    throw std::runtime_error("Missing DIMACS problem line (p min n m)");
+}
+
+/**
+ * @brief Parse the DIMACS lines in [p, end) into the chunk buffers
+ */
+void parseDimacsChunk(const char *p, const char *end, int numNodes,
+                      ChunkBuffers &out) {
+    auto valid = [&](int node) { return node >= 1 && node <= numNodes; };
+
+    while (p < end) {
+        const char *eol = findNewline(p, end);
+        ++out.lines;
+        LineParser lp(p, eol);
+        p = eol + 1;
+
+        switch (lp.peek()) {
+        case '\0':
+        case 'c':
+            break;
+        case 'p':
+            ++out.problemLines;
+            break;
+        case 'n': {
+            lp.skip('n');
+            int id;
+            double supply;
+            if (!lp.read(id) || !lp.read(supply) || !lp.atEnd())
+                return out.fail("Malformed node line");
+            if (!valid(id))
+                return out.fail("Node out of range: " + to_string(id));
+            out.nodeIds.push_back(id);
+            out.supplies.push_back(supply);
+            break;
+        }
+        case 'a': {
+            lp.skip('a');
+            int from, to;
+            double low, cap, cost;
+            if (!lp.read(from) || !lp.read(to) || !lp.read(low) ||
+                !lp.read(cap) || !lp.read(cost) || !lp.atEnd())
+                return out.fail("Malformed arc line");
+            if (!valid(from) || !valid(to))
+                return out.fail("Invalid node in edge: " + to_string(from) +
+                                "->" + to_string(to));
+            if (low != 0.0)
+                return out.fail("Nonzero lower bounds are not supported");
+            if (cap < out.minCapacity) {
+                out.minCapacity = cap;
+                out.minCapacityLine = out.lines;
+            }
+            out.from.push_back(from);
+            out.to.push_back(to);
+            out.cost.push_back(cost);
+            break;
+        }
+        default:
+            return out.fail("Unknown line type");
+        }
+    }
+}
+
+/**
+ * @brief Parse the CSV edge list lines in [p, end) into the chunk buffers
+ * @param allowHeader True if the first line may be a column header
+ */
+void parseCsvChunk(const char *p, const char *end, bool allowHeader,
+                   ChunkBuffers &out) {
+    while (p < end) {
+        const char *eol = findNewline(p, end);
+        ++out.lines;
+        LineParser lp(p, eol);
+        p = eol + 1;
+
+        if (lp.atEnd())
+            continue;
+
+        int from, to;
+        double cost;
+        if (!lp.read(from) || !lp.skip(',') || !lp.read(to) ||
+            !lp.skip(',') || !lp.read(cost) || !lp.atEnd()) {
+            if (allowHeader && out.lines == 1)
+                continue;
+            return out.fail("Malformed edge row");
+        }
+        if (from < 1 || to < 1)
+            return out.fail("Invalid node in edge: " + to_string(from) +
+                            "->" + to_string(to));
+        out.maxNode = std::max(out.maxNode, std::max(from, to));
+        out.from.push_back(from);
+        out.to.push_back(to);
+        out.cost.push_back(cost);
+    }
+}
+
+/**
+ * @brief Split part of the file into chunks that start at line boundaries
+ * @param begin Offset of the first byte, at the start of a line
+ * @param end Offset one past the last byte, at the start of a line or EOF
+ * @return Chunk start offsets, terminated by end
+ */
+vector<size_t> splitAtLines(const MappedFile &file, size_t begin, size_t end,
+                            const ReaderOptions &opts) {
+    size_t size = end - begin;
+    size_t chunks = size / std::max<size_t>(opts.minChunkBytes, 1);
+    chunks = std::min<size_t>(chunks, size_t(workerCount(opts.threads)) * 4);
+    chunks = std::max<size_t>(chunks, 1);
+
+    vector<size_t> bounds{begin};
+    for (size_t c = 1; c < chunks; ++c) {
+        size_t pos = std::max(bounds.back(), begin + size / chunks * c);
+        const char *nl = findNewline(file.begin() + pos, file.begin() + end);
+        pos = nl == file.begin() + end ? end : size_t(nl - file.begin()) + 1;
+        if (pos > bounds.back() && pos < end)
+            bounds.push_back(pos);
+    }
+    bounds.push_back(end);
+    return bounds;
+}
+
+/**
+ * @brief End of a window, moved forward to a line boundary
+ * @param begin Offset of the window, at the start of a line
+ * @param bytes Size of the window before alignment
+ * @return Offset of the first line after the window, or the file size
+ */
+size_t windowEnd(const MappedFile &file, size_t begin, size_t bytes) {
+    if (bytes >= file.size() - begin)
+        return file.size();
+    const char *nl = findNewline(file.begin() + begin + bytes, file.end());
+    return nl == file.end() ? file.size() : size_t(nl - file.begin()) + 1;
+}
+
+/**
+ * Parsed bytes per text byte budgeted for a window: an edge takes 16 bytes
+ * parsed and at least 6 ("1,2,3\n") as text, plus slack for buffer growth
+ */
+constexpr size_t PARSED_BYTES_PER_TEXT_BYTE = 4;
+
+} // namespace
+
+/**
+ * @brief Read a network flow instance from a file
+ * @param path Path to the instance file
+ * @param format File format
+ * @param opts Reader options
+ * @return Network with all nodes, balances and edges from the file
+ * @throws std::runtime_error If the file cannot be read or is malformed
+ *
+ * The file is parsed in three steps:
+ * - the mapping is split into chunks at newline boundaries,
+ * - each chunk is parsed by a worker thread into its own SoA buffers,
+ * - the buffers are appended to the network in file order.
+ *
+ * With an edge store these steps repeat for windows of the file whose
+ * parsed edges fit in the memory budget, and every window is written to the
+ * store before the next is parsed, so memory use does not grow with the
+ * number of edges. The file is left incomplete if reading fails.
+ *
+ * Arcs are uncapacitated, so a DIMACS arc whose capacity is below the total
+ * supply, and could therefore bind, is rejected rather than ignored.
+ */
+NetworkFlow readInstance(const string &path, InstanceFormat format,
+                         const ReaderOptions &opts) {
+    TraceScope trace("read instance", "io");
+    MappedFile file(path);
+
+    ProblemLine prob;
+    if (format == InstanceFormat::Dimacs)
+        prob = readProblemLine(file);
+
+    unique_ptr<EdgeStoreWriter> writer;
+    size_t window = file.size();
+    if (!opts.edgeStorePath.empty()) {
+        writer = make_unique<EdgeStoreWriter>(opts.edgeStorePath);
+        window = std::max(opts.memoryBudget / PARSED_BYTES_PER_TEXT_BYTE,
+                          opts.minChunkBytes);
+    }
+
+    vector<ChunkBuffers> chunks;
+    size_t totalEdges = 0;
+    size_t problemLines = 0;
+    size_t firstLine = 1;
+    int maxNode = 0;
+    double minCapacity = std::numeric_limits<double>::infinity();
+    size_t minCapacityLine = 0;
+    for (size_t offset = 0; offset < file.size();) {
+        size_t end = windowEnd(file, offset, window);
+        vector<size_t> bounds = splitAtLines(file, offset, end, opts);
+        vector<ChunkBuffers> parsed(bounds.size() - 1);
+
+        parallelTasks(parsed.size(), opts.threads, [&](size_t c) {
+            file.prefetch(bounds[c], bounds[c + 1]);
+            const char *b = file.begin() + bounds[c];
+            const char *e = file.begin() + bounds[c + 1];
+            if (format == InstanceFormat::Dimacs)
+                parseDimacsChunk(b, e, prob.nodes, parsed[c]);
+            else
+                parseCsvChunk(b, e, bounds[c] == 0, parsed[c]);
+        });
+
+        for (auto &chunk : parsed) {
+            if (!chunk.error.empty())
+                throw std::runtime_error(
+                    chunk.error + " at line " +
+                    to_string(firstLine + chunk.errorLine - 1) + " of " +
+                    path);
+            if (chunk.minCapacity < minCapacity) {
+                minCapacity = chunk.minCapacity;
+                minCapacityLine = firstLine + chunk.minCapacityLine - 1;
+            }
+            firstLine += chunk.lines;
+            totalEdges += chunk.from.size();
+            problemLines += chunk.problemLines;
+            maxNode = std::max(maxNode, chunk.maxNode);
+
+            // Stored edges leave memory now; node lines are kept
+            if (writer) {
+                writer->append(chunk.from.data(), chunk.to.data(),
+                               chunk.cost.data(), chunk.from.size());
+                vector<int>().swap(chunk.from);
+                vector<int>().swap(chunk.to);
+                vector<double>().swap(chunk.cost);
+            }
+            chunks.push_back(std::move(chunk));
+        }
+        offset = end;
+    }
+
+    if (format == InstanceFormat::Dimacs) {
+        if (problemLines != 1)
+            throw std::runtime_error("Expected one problem line in " + path);
+        if (totalEdges != prob.arcs)
+            throw std::runtime_error(
+                "Problem line declares " + to_string(prob.arcs) +
+                " arcs, found " + to_string(totalEdges) + " in " + path);
+        maxNode = prob.nodes;
+    } else if (maxNode == 0) {
+        throw std::runtime_error("No edges found in " + path);
+    }
+
+    auto checkCapacities = [&](const NetworkFlow &net) {
+        double supply = 0.0;
+        for (int v = 1; v <= net.getNumNodes(); ++v)
+            supply += std::max(net.getBalance(v), 0.0);
+        if (minCapacity < supply)
+            throw std::runtime_error(
+                "Arc capacity below the total supply at line " +
+                to_string(minCapacityLine) + " of " + path +
+                "; capacitated arcs are not supported");
+    };
+
+    if (writer) {
+        writer->finish();
+        NetworkFlow net(maxNode, make_shared<const EdgeStore>(
+                                     opts.edgeStorePath, opts.memoryBudget));
+        for (const auto &chunk : chunks)
+            for (size_t i = 0; i < chunk.nodeIds.size(); ++i)
+                net.setBalance(chunk.nodeIds[i], chunk.supplies[i]);
+        checkCapacities(net);
+        return net;
+    }
+
+    NetworkFlow net(maxNode);
+    net.reserveEdges(totalEdges);
+    for (const auto &chunk : chunks) {
+        for (size_t i = 0; i < chunk.nodeIds.size(); ++i)
+            net.setBalance(chunk.nodeIds[i], chunk.supplies[i]);
+        net.addEdges(chunk.from.data(), chunk.to.data(), chunk.cost.data(),
+                     chunk.from.size());
+    }
+    checkCapacities(net);
+    return net;
+}
+
+/**
+ * @brief Guess the instance format from a file name extension
+ * @param path File name ending in .csv, .min, .dimacs or .net
+ * @return Matching instance format
+ * @throws std::invalid_argument If the extension is not recognised
+ */
+InstanceFormat instanceFormatFromPath(const string &path) {
+    auto endsWith = [&](const char *ext) {
+        size_t n = strlen(ext);
+        return path.size() >= n && path.compare(path.size() - n, n, ext) == 0;
+    };
+    if (endsWith(".csv"))
+        return InstanceFormat::Csv;
+    if (endsWith(".min") || endsWith(".dimacs") || endsWith(".net"))
+        return InstanceFormat::Dimacs;
+    throw std::invalid_argument("Unknown instance format for file: " + path);
+}
@@ -0,0 +1,390 @@
+/**
+ * @file Metrics.cpp
+ * @brief Metric registry, Prometheus rendering and exporters
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ */
+
+#include "Metrics.hpp"
+#include <arpa/inet.h>
+#include <cstdio>
+#include <memory>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+
+/// Poll interval of the socket exporter while it waits for connections
+constexpr int ACCEPT_POLL_MS = 200;
+/// Time a scraper gets to send its request before the answer goes out
+constexpr int REQUEST_WAIT_MS = 1000;
+
+/**
+ * @struct MetricSeries
+ * @brief One label set of a family
+ */
+struct MetricSeries {
+    string labels; ///< Rendered as name="value" pairs without braces
+    unique_ptr<MetricCounter> counter;
+    unique_ptr<MetricHistogram> histogram;
+};
+
+/**
+ * @struct MetricFamily
+ * @brief Metrics sharing a name, help text and type
+ */
+struct MetricFamily {
+    string name;
+    string help;
+    bool isHistogram;
+    vector<MetricSeries> series;
+};
+
+/**
+ * @brief Escape a label value or help text for the exposition format
+ * @param text Text to escape
+ * @param quotes Whether double quotes are escaped too (label values)
+ * @return Escaped text
+ */
+string escape(const string &text, bool quotes) {
+    string out;
+    out.reserve(text.size());
+    for (char c : text) {
+        if (c == '\\')
+            out += "\\\\";
+        else if (c == '\n')
+            out += "\\n";
+        else if (c == '"' && quotes)
+            out += "\\\"";
+        else
+            out += c;
+    }
+    return out;
+}
+
+/**
+ * @brief Render a label set
+ * @param labels Label names and values
+ * @return name="value" pairs separated by commas
+ */
+string renderLabels(const Metrics::Labels &labels) {
+    string out;
+    for (const auto &[name, value] : labels) {
+        if (!out.empty())
+            out += ',';
+        out += name + "=\"" + escape(value, true) + '"';
+    }
+    return out;
+}
+
+/**
+ * @brief Format a number for a sample line
+ * @param value Number to format
+ * @return Shortest "%.9g" style representation
+ */
+string formatValue(double value) {
+    char text[32];
+    snprintf(text, sizeof(text), "%.9g", value);
+    return text;
+}
+
+/**
+ * @class MetricRegistry
+ * @brief Families in registration order
+ */
+class MetricRegistry {
+private:
+    mutex lock;
+    vector<MetricFamily> families;
+
+    MetricSeries &find(const string &name, const string &help,
+                       bool isHistogram, const string &labels) {
+        MetricFamily *family = nullptr;
+        for (MetricFamily &f : families)
+            if (f.name == name)
+                family = &f;
+        if (!family) {
+            families.push_back({name, help, isHistogram, {}});
+            family = &families.back();
+        }
+        if (family->isHistogram != isHistogram)
+            throw std::logic_error("Metric " + name +
+                                   " is registered with another type");
+        for (MetricSeries &s : family->series)
+            if (s.labels == labels)
+                return s;
+        family->series.push_back({labels, nullptr, nullptr});
+        return family->series.back();
+    }
+
+public:
+    MetricCounter &counter(const string &name, const string &help,
+                           const string &labels) {
+        lock_guard<mutex> guard(lock);
+        MetricSeries &s = find(name, help, false, labels);
+        if (!s.counter)
+            s.counter = make_unique<MetricCounter>();
+        return *s.counter;
+    }
+
+    MetricHistogram &histogram(const string &name, const string &help,
+                               double unit, const string &labels) {
+        lock_guard<mutex> guard(lock);
+        MetricSeries &s = find(name, help, true, labels);
+        if (!s.histogram)
+            s.histogram = make_unique<MetricHistogram>(unit);
+        return *s.histogram;
+    }
+
+    string exposition() {
+        string out;
+        lock_guard<mutex> guard(lock);
+        for (const MetricFamily &f : families) {
+            out += "# HELP " + f.name + ' ' + escape(f.help, false) + '\n';
+            out += "# TYPE " + f.name +
+                   (f.isHistogram ? " histogram\n" : " counter\n");
+            for (const MetricSeries &s : f.series) {
+                if (f.isHistogram) {
+                    s.histogram->render(out, f.name, s.labels);
+                    continue;
+                }
+                out += f.name;
+                if (!s.labels.empty())
+                    out += '{' + s.labels + '}';
+                out += ' ' + to_string(s.counter->get()) + '\n';
+            }
+        }
+        return out;
+    }
+};
+
+MetricRegistry &registry() {
+    static MetricRegistry instance;
+    return instance;
+}
+
+/**
+ * @brief Send a whole buffer over a socket
+ * @param fd Connected socket
+ * @param text Data to send
+ */
+void sendAll(int fd, const string &text) {
+    size_t sent = 0;
+    while (sent < text.size()) {
+        ssize_t n = ::send(fd, text.data() + sent, text.size() - sent,
+                           MSG_NOSIGNAL);
+        if (n <= 0)
+            return;
+        sent += static_cast<size_t>(n);
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Largest sample of a bucket
+ * @param index Bucket index
+ * @return Inclusive upper bound of the bucket in sample units
+ */
+uint64_t MetricHistogram::upperBound(size_t index) {
+    if (index < SUB_BUCKETS)
+        return index;
+    const size_t shift = index / SUB_BUCKETS - 1;
+    const uint64_t sub = index % SUB_BUCKETS;
+    // Wraps to the largest uint64_t for the last bucket
+    return ((SUB_BUCKETS + sub + 1) << shift) - 1;
+}
+
+/**
+ * @brief Append the histogram as Prometheus sample lines
+ * @param out Output text
+ * @param name Metric family name
+ * @param labels Rendered labels without braces, possibly empty
+ */
+void MetricHistogram::render(string &out, const string &name,
+                             const string &labels) const {
+    const string prefix = labels.empty() ? "" : labels + ',';
+    uint64_t cumulative = 0;
+    for (size_t b = 0; b < BUCKETS; ++b) {
+        const uint64_t count = counts[b].load(memory_order_relaxed);
+        if (count == 0)
+            continue;
+        cumulative += count;
+        out += name + "_bucket{" + prefix + "le=\"" +
+               formatValue(static_cast<double>(upperBound(b)) * unit) +
+               "\"} " + to_string(cumulative) + '\n';
+    }
+    out += name + "_bucket{" + prefix + "le=\"+Inf\"} " +
+           to_string(cumulative) + '\n';
+    const string braces = labels.empty() ? "" : '{' + labels + '}';
+    out += name + "_sum" + braces + ' ' +
+           formatValue(static_cast<double>(
+                           total.load(memory_order_relaxed)) *
+                       unit) +
+           '\n';
+    out += name + "_count" + braces + ' ' + to_string(cumulative) + '\n';
+}
+
+/**
+ * @brief Find or create a counter
+ * @param name Metric family name, e.g. "networkflow_solves_total"
+ * @param help Description for the HELP line
+ * @param labels Label names and values of this series
+ * @return Counter that lives as long as the process
+ * @throws std::logic_error If the name is registered as a histogram
+ */
+MetricCounter &Metrics::counter(const string &name, const string &help,
+                                const Labels &labels) {
+    return registry().counter(name, help, renderLabels(labels));
+}
+
+/**
+ * @brief Find or create a histogram
+ * @param name Metric family name, e.g. "networkflow_solve_seconds"
+ * @param help Description for the HELP line
+ * @param unit Value of one sample unit in the exported unit
+ * @param labels Label names and values of this series
+ * @return Histogram that lives as long as the process
+ * @throws std::logic_error If the name is registered as a counter
+ */
+MetricHistogram &Metrics::histogram(const string &name, const string &help,
+                                    double unit, const Labels &labels) {
+    return registry().histogram(name, help, unit, renderLabels(labels));
+}
+
+/**
+ * @brief Render every metric
+ * @return Prometheus text exposition format, version 0.0.4
+ */
+string Metrics::exposition() { return registry().exposition(); }
+
+/**
+ * @brief Write the exposition to a file
+ * @param path File to replace, through a renamed temporary file
+ * @throws std::runtime_error If the file cannot be written
+ */
+void Metrics::write(const string &path) {
+    const string text = exposition();
+    const string temporary = path + ".tmp";
+    std::FILE *file = std::fopen(temporary.c_str(), "wb");
+    if (!file)
+        throw std::runtime_error("Cannot open metrics file: " + temporary);
+    bool written =
+        std::fwrite(text.data(), 1, text.size(), file) == text.size();
+    if (std::fclose(file) != 0 || !written ||
+        std::rename(temporary.c_str(), path.c_str()) != 0)
+        throw std::runtime_error("Failed to write metrics file: " + path);
+}
+
+/**
+ * @brief Rewrite a file periodically
+ * @param path File to write
+ * @param period Time between writes
+ * @throws std::runtime_error If the first write fails
+ */
+MetricsExporter::MetricsExporter(const string &path,
+                                 chrono::milliseconds period) {
+    Metrics::write(path);
+    worker = thread([this, path, period]() { writeLoop(path, period); });
+}
+
+/**
+ * @brief Serve the exposition on a local TCP port
+ * @param port Port on 127.0.0.1
+ * @throws std::runtime_error If the port cannot be bound
+ */
+MetricsExporter::MetricsExporter(unsigned short port) {
+    listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listener < 0)
+        throw std::runtime_error("Cannot create metrics socket");
+    int reuse = 1;
+    ::setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::bind(listener, reinterpret_cast<sockaddr *>(&address),
+               sizeof(address)) != 0 ||
+        ::listen(listener, 16) != 0) {
+        ::close(listener);
+        throw std::runtime_error("Cannot listen for metrics on port " +
+                                 to_string(port));
+    }
+    worker = thread([this]() { serveLoop(); });
+}
+
+MetricsExporter::~MetricsExporter() {
+    {
+        lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    worker.join();
+    if (listener >= 0)
+        ::close(listener);
+}
+
+/**
+ * @brief Write the file every period until stopped, and once more then
+ * @param path File to write
+ * @param period Time between writes
+ *
+ * Failed writes are retried at the next period.
+ */
+void MetricsExporter::writeLoop(string path, chrono::milliseconds period) {
+    unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        bool stop = wake.wait_for(lock, period, [&]() { return stopping; });
+        lock.unlock();
+        try {
+            Metrics::write(path);
+        } catch (const std::runtime_error &) {
+        }
+        if (stop)
+            return;
+        lock.lock();
+    }
+}
+
+/**
+ * @brief Answer connections with the exposition until stopped
+ *
+ * Any request gets the metrics as an HTTP/1.0 response, which is what a
+ * Prometheus scrape or curl expects.
+ */
+void MetricsExporter::serveLoop() {
+    while (true) {
+        {
+            lock_guard<std::mutex> lock(mutex);
+            if (stopping)
+                return;
+        }
+        pollfd waiting{listener, POLLIN, 0};
+        if (::poll(&waiting, 1, ACCEPT_POLL_MS) <= 0)
+            continue;
+        int client = ::accept(listener, nullptr, nullptr);
+        if (client < 0)
+            continue;
+
+        pollfd request{client, POLLIN, 0};
+        if (::poll(&request, 1, REQUEST_WAIT_MS) > 0) {
+            char buffer[4096];
+            if (::recv(client, buffer, sizeof(buffer), 0) < 0) {
+                ::close(client);
+                continue;
+            }
+        }
+        const string body = Metrics::exposition();
+        sendAll(client,
+                "HTTP/1.0 200 OK\r\n"
+                "Content-Type: text/plain; version=0.0.4\r\n"
+                "Content-Length: " +
+                    to_string(body.size()) + "\r\n\r\n" + body);
+        ::close(client);
+    }
+}
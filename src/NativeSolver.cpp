@@ -0,0 +1,355 @@
+/**
+ * @file NativeSolver.cpp
+ * @brief Integer scaling and result assembly for the native backends
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ */
+
+#include "NativeSolver.hpp"
+#include "GraphOrder.hpp"
+#include "ShortestPath.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+
+/// Largest number of decimal places removed by scaling
+constexpr int MAX_DECIMALS = 6;
+
+/// Magnitude bound for sums of scaled values (2^62)
+constexpr double INTEGRAL_LIMIT = 4611686018427387904.0;
+
+/**
+ * @brief Find the smallest power of ten that makes every value integral
+ * @param values Values to scale
+ * @param limit Largest magnitude allowed after scaling
+ * @return Scale factor, or 0 if none up to 10^MAX_DECIMALS works
+ */
+double decimalScale(const vector<double> &values, double limit) {
+    int decimals = 0;
+    double scale = 1.0;
+    for (double x : values) {
+        while (true) {
+            double y = x * scale;
+            if (!(std::abs(y) <= limit))
+                return 0.0;
+            double tol = 1e-9 * std::max(1.0, std::abs(y));
+            if (std::abs(y - std::round(y)) <= tol)
+                break;
+            if (++decimals > MAX_DECIMALS)
+                return 0.0;
+            scale *= 10.0;
+        }
+    }
+    return scale;
+}
+
+} // namespace
+
+/**
+ * @brief Route all supplies to the demands, ignoring costs
+ * @param inst Scaled instance
+ * @param flow Receives the scaled flow on each arc
+ * @return True if a feasible flow exists
+ *
+ * Dinic's maximum flow from a super source feeding every supply node to a
+ * super sink draining every demand node; network arcs have unlimited
+ * capacity.
+ */
+bool feasibleFlow(const IntegralInstance &inst, vector<long long> &flow) {
+    const FlowGraph &g = inst.graph;
+    const int n = g.numNodes;
+    const int src = n, sink = n + 1;
+    const long long INF = numeric_limits<long long>::max() / 4;
+
+    // Residual arcs in pairs (2k forward, 2k + 1 backward)
+    vector<int> head, next, first(n + 2, -1);
+    vector<long long> cap;
+    auto addArc = [&](int u, int v, long long c) {
+        head.push_back(v), cap.push_back(c), next.push_back(first[u]);
+        first[u] = static_cast<int>(head.size()) - 1;
+        head.push_back(u), cap.push_back(0), next.push_back(first[v]);
+        first[v] = static_cast<int>(head.size()) - 1;
+    };
+    for (size_t a = 0; a < g.numArcs(); ++a) {
+        bool loop = g.source[a] == g.target[a];
+        addArc(g.source[a], g.target[a], loop ? 0 : INF);
+    }
+    for (int v = 0; v < n; ++v) {
+        if (inst.supply[v] > 0)
+            addArc(src, v, inst.supply[v]);
+        else if (inst.supply[v] < 0)
+            addArc(v, sink, -inst.supply[v]);
+    }
+
+    vector<int> level(n + 2), it(n + 2), queue(n + 2);
+    auto bfs = [&]() {
+        fill(level.begin(), level.end(), -1);
+        size_t qh = 0, qt = 0;
+        level[src] = 0;
+        queue[qt++] = src;
+        while (qh < qt) {
+            int u = queue[qh++];
+            for (int e = first[u]; e >= 0; e = next[e]) {
+                if (cap[e] > 0 && level[head[e]] < 0) {
+                    level[head[e]] = level[u] + 1;
+                    queue[qt++] = head[e];
+                }
+            }
+        }
+        return level[sink] >= 0;
+    };
+    // Iterative blocking-flow search along level-increasing arcs
+    auto dfs = [&]() {
+        vector<int> path;
+        long long total = 0;
+        int u = src;
+        while (true) {
+            if (u == sink) {
+                long long d = INF;
+                for (int e : path)
+                    d = min(d, cap[e]);
+                for (int e : path) {
+                    cap[e] -= d;
+                    cap[e ^ 1] += d;
+                }
+                total += d;
+                path.clear();
+                u = src;
+                continue;
+            }
+            int &e = it[u];
+            while (e >= 0 && !(cap[e] > 0 && level[head[e]] == level[u] + 1))
+                e = next[e];
+            if (e >= 0) {
+                path.push_back(e);
+                u = head[e];
+            } else {
+                if (u == src)
+                    return total;
+                level[u] = -1;
+                u = head[path.back() ^ 1];
+                path.pop_back();
+            }
+        }
+    };
+
+    long long total = 0;
+    while (bfs()) {
+        it = first;
+        total += dfs();
+    }
+
+    // Flow on a network arc is the capacity of its backward residual arc
+    flow.resize(g.numArcs());
+    for (size_t a = 0; a < flow.size(); ++a)
+        flow[a] = cap[2 * a + 1];
+    return total == inst.totalSupply;
+}
+
+/**
+ * @brief Scale a network to integers
+ * @param net Source network
+ * @param threads Worker threads for building the graph
+ *
+ * Values of magnitude up to 2^62 / n are accepted, so any simple path cost
+ * or any total of supplies stays inside a 64-bit integer.
+ */
+IntegralInstance::IntegralInstance(const NetworkFlow &net, unsigned threads,
+                                   NodeOrder order)
+    : graph(net, threads), costScale(0.0), supplyScale(0.0), totalSupply(0) {
+    TraceScope trace("prepare instance");
+    const size_t n = static_cast<size_t>(graph.numNodes);
+    const double limit =
+        INTEGRAL_LIMIT / static_cast<double>(std::max<size_t>(n, 1));
+
+    nodeId = nodeOrdering(graph, order);
+    if (!nodeId.empty())
+        graph = renumberGraph(graph, nodeId, arcId, threads);
+    condensation = Condensation(graph);
+
+    vector<double> balances(n);
+    for (size_t v = 0; v < n; ++v)
+        balances[v] = net.getBalance(userNode(static_cast<int>(v)) + 1);
+
+    costScale = decimalScale(graph.cost, limit);
+    supplyScale = decimalScale(balances, limit);
+    if (costScale == 0.0) {
+        error = "Costs need more than " + to_string(MAX_DECIMALS) +
+                " decimal places or are too large for integer arithmetic";
+        return;
+    }
+    if (supplyScale == 0.0) {
+        error = "Balances need more than " + to_string(MAX_DECIMALS) +
+                " decimal places or are too large for integer arithmetic";
+        return;
+    }
+
+    cost.resize(graph.numArcs());
+    for (size_t a = 0; a < cost.size(); ++a)
+        cost[a] = std::llround(graph.cost[a] * costScale);
+
+    supply.resize(n);
+    for (size_t v = 0; v < n; ++v) {
+        supply[v] = std::llround(balances[v] * supplyScale);
+        if (supply[v] > 0)
+            totalSupply += supply[v];
+    }
+}
+
+/**
+ * @brief Initial arena size for the scratch data of a native engine
+ * @param inst Scaled instance
+ * @return Bytes for a handful of arrays per node and per arc
+ */
+size_t arenaBytes(const IntegralInstance &inst) {
+    return 64 * static_cast<size_t>(inst.graph.numNodes) +
+           16 * inst.graph.numArcs();
+}
+
+/**
+ * @brief Check the preconditions shared by all native engines
+ * @param net Network being solved
+ * @param inst Scaled instance
+ * @param result Receives the status when a precondition fails
+ * @param threads Worker threads for the negative cycle search
+ * @return True if the engine may run
+ */
+bool nativePrecheck(const NetworkFlow &net, const IntegralInstance &inst,
+                    Solution &result, unsigned threads) {
+    TraceScope trace("presolve");
+    if (!inst.ok()) {
+        result.status = inst.error;
+        return false;
+    }
+
+    long long netSupply = 0;
+    for (long long b : inst.supply)
+        netSupply += b;
+    if (!net.isBalanced() || netSupply != 0) {
+        result.status = "Infeasible";
+        return false;
+    }
+
+    if (!findNegativeCycle(inst.graph, inst.condensation, threads).empty()) {
+        vector<long long> flow;
+        bool routable = feasibleFlow(inst, flow);
+        result.status = routable ? "Unbounded" : "Infeasible";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Scale warm-start potentials into integer units
+ * @param options Solve options holding the potentials
+ * @param inst Scaled instance
+ * @return Integral potentials, all zero when none were supplied
+ * @throws std::invalid_argument If the number of potentials is wrong
+ *
+ * Potentials are rounded to the cost grid; the engines only use them as a
+ * starting point, so rounding affects speed but not the result.
+ */
+vector<long long> scaledPotentials(const SolveOptions &options,
+                                   const IntegralInstance &inst) {
+    const size_t n = static_cast<size_t>(inst.graph.numNodes);
+    vector<long long> pi(n, 0);
+    if (options.initialPotentials.empty())
+        return pi;
+
+    if (options.initialPotentials.size() != n)
+        throw std::invalid_argument(
+            "Expected " + to_string(n) + " initial potentials, got " +
+            to_string(options.initialPotentials.size()));
+
+    const double limit =
+        INTEGRAL_LIMIT / static_cast<double>(std::max<size_t>(n, 1));
+    for (size_t v = 0; v < n; ++v) {
+        double p =
+            options.initialPotentials[inst.userNode(static_cast<int>(v))] *
+            inst.costScale;
+        if (std::isfinite(p) && std::abs(p) <= limit)
+            pi[v] = std::llround(p);
+    }
+    return pi;
+}
+
+/**
+ * @brief Scale a starting flow into integer units
+ * @param options Solve options holding the flow
+ * @param inst Scaled instance
+ * @return Integral flow on each arc, empty when none was supplied
+ * @throws std::invalid_argument If the flow has the wrong size, is negative
+ *         or does not satisfy flow conservation on the supply grid
+ */
+vector<long long> scaledFlows(const SolveOptions &options,
+                              const IntegralInstance &inst) {
+    const FlowGraph &g = inst.graph;
+    if (options.initialFlows.empty())
+        return {};
+
+    if (options.initialFlows.size() != g.numArcs())
+        throw std::invalid_argument(
+            "Expected " + to_string(g.numArcs()) + " initial flows, got " +
+            to_string(options.initialFlows.size()));
+
+    vector<long long> flow(g.numArcs());
+    vector<long long> excess(inst.supply);
+    for (size_t a = 0; a < flow.size(); ++a) {
+        double x = options.initialFlows[inst.userArc(a)] * inst.supplyScale;
+        if (!(x >= -0.5 && x <= INTEGRAL_LIMIT))
+            throw std::invalid_argument("Initial flow on edge " +
+                                        to_string(inst.userArc(a)) +
+                                        " is out of range");
+        flow[a] = std::llround(x);
+        excess[g.source[a]] -= flow[a];
+        excess[g.target[a]] += flow[a];
+    }
+    for (size_t v = 0; v < excess.size(); ++v)
+        if (excess[v] != 0)
+            throw std::invalid_argument(
+                "Initial flow violates conservation at node " +
+                to_string(inst.userNode(static_cast<int>(v)) + 1));
+    return flow;
+}
+
+/**
+ * @brief Assemble an optimal Solution from integral engine results
+ * @param net Network that was solved
+ * @param inst Scaled instance
+ * @param flow Scaled flow on each arc
+ * @param potential Scaled node potentials (reduced cost c + pi_u - pi_v)
+ * @return Solution marked optimal, with flows and potentials unscaled
+ */
+Solution nativeSolution(const NetworkFlow &net, const IntegralInstance &inst,
+                        const vector<long long> &flow,
+                        const vector<long long> &potential) {
+    TraceScope trace("extract");
+    Solution result;
+    result.solved = true;
+    result.status = "Optimal";
+
+    result.edgeFlows.resize(flow.size());
+    for (size_t a = 0; a < flow.size(); ++a)
+        result.edgeFlows[inst.userArc(a)] =
+            static_cast<double>(flow[a]) / inst.supplyScale;
+    net.sweepEdges([&](const EdgeBlock &block) {
+        for (size_t i = 0; i < block.count; ++i) {
+            double x = result.edgeFlows[block.first + i];
+            result.totalCost += block.cost[i] * x;
+            if (x > 1e-6)
+                result.flows[{block.from[i], block.to[i]}] += x;
+        }
+    });
+
+    result.potentials.resize(potential.size());
+    for (size_t v = 0; v < potential.size(); ++v)
+        result.potentials[inst.userNode(static_cast<int>(v))] =
+            static_cast<double>(potential[v]) / inst.costScale;
+    return result;
+}
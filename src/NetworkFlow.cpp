@@ -6,10 +6,29 @@
  */
 
 #include "NetworkFlow.hpp"
+#include "CapacityScalingSolver.hpp"
+#include "CycleCancelingSolver.hpp"
+#include "FlowGraph.hpp"
+#include "Metrics.hpp"
+#include "NetworkSimplexSolver.hpp"
+#include "Parallel.hpp"
+#include "RelaxationSolver.hpp"
+#include "ShortestPath.hpp"
+#include "SimplexBasis.hpp"
+#include "SolveArena.hpp"
+#include "Trace.hpp"
+#include "TransportationSolver.hpp"
+#include "TreeSolver.hpp"
 #include <ilcplex/ilocplex.h>
-#include <numeric>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
 #include <stdexcept>
 #include <cmath>
+#include <memory>
+#include <mutex>
 
 using namespace std;
 
@@ -23,6 +42,38 @@ using namespace std;
  */
 NetworkFlow::NetworkFlow(int n) : numNodes(n), balances(n, 0.0) {}
 
+/**
+ * @brief Construct a network whose edges live in an edge store
+ * @param n Number of nodes in the network (1-indexed)
+ * @param edgeStore Edges of the network
+ * @throws std::out_of_range If an edge of the store uses a node outside
+ *         [1, n]
+ *
+ * The store records its node range, so the check does not read the edges.
+ */
+NetworkFlow::NetworkFlow(int n, shared_ptr<const EdgeStore> edgeStore)
+    : numNodes(n), balances(n, 0.0), store(std::move(edgeStore)) {
+    if (!store)
+        throw std::invalid_argument("Edge store must not be null");
+    if (store->size() > 0 &&
+        (store->lowestNode() < 1 || store->highestNode() > numNodes))
+        throw std::out_of_range(
+            "Edge store uses nodes " + to_string(store->lowestNode()) +
+            ".." + to_string(store->highestNode()) + ", network has " +
+            to_string(numNodes));
+}
+
+/**
+ * @brief Reject an operation that needs the in-memory edge vector
+ * @param operation Name of the operation for the error message
+ * @throws std::logic_error If the edges live in an edge store
+ */
+void NetworkFlow::requireInMemory(const char *operation) const {
+    if (store)
+        throw std::logic_error(string(operation) +
+                               " is not available for stored edges");
+}
+
 /**
  * @brief Set the supply/demand balance for a specific node
  * @param node Node index (1-indexed)
@@ -52,12 +103,46 @@ void NetworkFlow::setBalance(int node, double b) {
  * pair of nodes are allowed.
  */
 void NetworkFlow::addEdge(int from, int to, double cost) {
+    requireInMemory("addEdge");
     if (from < 1 || from > numNodes || to < 1 || to > numNodes)
         throw std::out_of_range("Invalid node in edge: " + to_string(from) +
                                 "->" + to_string(to));
     edges.emplace_back(from, to, cost);
 }
 
+/**
+ * @brief Append a batch of directed edges stored as parallel arrays
+ * @param from Source node indices (1-indexed)
+ * @param to Destination node indices (1-indexed)
+ * @param cost Costs per unit of flow
+ * @param count Number of edges in the arrays
+ * @throws std::out_of_range If any node index is invalid
+ *
+ * All indices are checked before the first edge is appended, so a failed
+ * call leaves the network unchanged.
+ */
+void NetworkFlow::addEdges(const int *from, const int *to, const double *cost,
+                           size_t count) {
+    requireInMemory("addEdges");
+    for (size_t i = 0; i < count; ++i) {
+        if (from[i] < 1 || from[i] > numNodes || to[i] < 1 || to[i] > numNodes)
+            throw std::out_of_range("Invalid node in edge: " +
+                                    to_string(from[i]) + "->" +
+                                    to_string(to[i]));
+    }
+    for (size_t i = 0; i < count; ++i)
+        edges.emplace_back(from[i], to[i], cost[i]);
+}
+
+/**
+ * @brief Reserve storage for a total number of edges
+ * @param count Expected number of edges
+ */
+void NetworkFlow::reserveEdges(size_t count) {
+    requireInMemory("reserveEdges");
+    edges.reserve(count);
+}
+
 /**
  * @brief Get the number of nodes in the network
  * @return Number of nodes
@@ -80,11 +165,128 @@ double NetworkFlow::getBalance(int node) const {
     return balances[node - 1];
 }
 
+/**
+ * @brief Get the number of edges in the network
+ * @return Number of edges
+ */
+size_t NetworkFlow::getNumEdges() const {
+    return store ? store->size() : edges.size();
+}
+
 /**
  * @brief Get a const reference to all edges in the network
  * @return Const reference to vector of Edge objects
+ * @throws std::logic_error If the edges live in an edge store
  */
-const vector<Edge> &NetworkFlow::getEdges() const { return edges; }
+const vector<Edge> &NetworkFlow::getEdges() const {
+    requireInMemory("getEdges");
+    return edges;
+}
+
+/**
+ * @brief Get the edge store holding the edges
+ * @return Store, or null for an in-memory network
+ */
+const shared_ptr<const EdgeStore> &NetworkFlow::getEdgeStore() const {
+    return store;
+}
+
+/**
+ * @brief Visit all edges in blocks of consecutive edges
+ * @param fn Callback receiving each block once
+ * @param threads Worker threads, 0 for hardware concurrency
+ *
+ * Stored edges are swept by the store itself. In-memory edges are copied
+ * block by block into per-thread column buffers, so callers see the same
+ * structure-of-arrays blocks in both modes.
+ */
+void NetworkFlow::sweepEdges(const EdgeSweep &fn, unsigned threads) const {
+    if (store) {
+        store->sweep(fn, threads);
+        return;
+    }
+
+    const size_t blocks = (edges.size() + EDGE_BLOCK - 1) / EDGE_BLOCK;
+    parallelChunks(blocks, 1, threads, [&](size_t, size_t begin, size_t end) {
+        vector<int> from(EDGE_BLOCK), to(EDGE_BLOCK);
+        vector<double> cost(EDGE_BLOCK);
+        for (size_t b = begin; b < end; ++b) {
+            EdgeBlock block;
+            block.first = b * EDGE_BLOCK;
+            block.count = std::min(EDGE_BLOCK, edges.size() - block.first);
+            for (size_t i = 0; i < block.count; ++i) {
+                const Edge &e = edges[block.first + i];
+                from[i] = e.from;
+                to[i] = e.to;
+                cost[i] = e.cost;
+            }
+            block.from = from.data();
+            block.to = to.data();
+            block.cost = cost.data();
+            fn(block);
+        }
+    });
+}
+
+/// Relative tolerance of the balance check, scaled by the total supply
+static constexpr double BALANCE_REL_TOLERANCE = 1e-12;
+/// Smallest absolute imbalance the balance check treats as nonzero
+static constexpr double BALANCE_ABS_TOLERANCE = 1e-9;
+
+/**
+ * @struct BalanceSums
+ * @brief Compensated sums over the node balances
+ */
+struct BalanceSums {
+    double net;    ///< Sum of all balances
+    double supply; ///< Sum of the positive balances
+};
+
+/**
+ * @brief Sum balances with Neumaier compensated summation
+ * @param b Balance values
+ * @return Net balance and total supply
+ *
+ * Four independent accumulator lanes break the serial dependency of a
+ * single running sum, so consecutive additions can overlap in the
+ * pipeline; each lane carries its own correction term. The result is
+ * exact for integral balances whose magnitudes sum to less than 2^53.
+ */
+static BalanceSums sumBalances(const vector<double> &b) {
+    constexpr size_t LANES = 4;
+    double sum[LANES] = {}, comp[LANES] = {}, supply[LANES] = {};
+
+    auto add = [](double &s, double &c, double x) {
+        double t = s + x;
+        c += std::abs(s) >= std::abs(x) ? (s - t) + x : (x - t) + s;
+        s = t;
+    };
+
+    size_t i = 0;
+    for (; i + LANES <= b.size(); i += LANES) {
+        for (size_t l = 0; l < LANES; ++l) {
+            add(sum[l], comp[l], b[i + l]);
+            supply[l] += b[i + l] > 0 ? b[i + l] : 0.0;
+        }
+    }
+    for (; i < b.size(); ++i) {
+        add(sum[0], comp[0], b[i]);
+        supply[0] += b[i] > 0 ? b[i] : 0.0;
+    }
+
+    double net = 0.0, correction = 0.0;
+    for (size_t l = 0; l < LANES; ++l) {
+        add(net, correction, sum[l]);
+        add(net, correction, comp[l]);
+    }
+    return {net + correction, supply[0] + supply[1] + supply[2] + supply[3]};
+}
+
+/**
+ * @brief Get the net balance of the network
+ * @return Sum of all node balances, computed with compensated summation
+ */
+double NetworkFlow::getImbalance() const { return sumBalances(balances).net; }
 
 /**
  * @brief Check if the network has balanced supply and demand
@@ -92,38 +294,552 @@ const vector<Edge> &NetworkFlow::getEdges() const { return edges; }
  * 
  * A network is balanced if the sum of all node balances equals zero.
  * This is a necessary condition for a feasible flow solution to exist.
- * Uses a tolerance of 1e-5 for floating-point comparison.
+ * The sum is compensated, so its error is far below the representation
+ * error of the inputs. The tolerance is 1e-12 of the total supply with an
+ * absolute floor of 1e-9, so large networks are neither rejected for
+ * rounding noise nor accepted with a real shortfall.
  */
 bool NetworkFlow::isBalanced() const {
-    double sum = std::accumulate(balances.begin(), balances.end(), 0.0);
-    return std::abs(sum) < 1e-5;
+    BalanceSums sums = sumBalances(balances);
+    return std::abs(sums.net) <= std::max(BALANCE_ABS_TOLERANCE,
+                                          BALANCE_REL_TOLERANCE * sums.supply);
+}
+
+/**
+ * @brief Format a number for validation messages
+ * @param value Number to format
+ * @return Shortest "%g" style representation
+ */
+static string formatAmount(double value) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%g", value);
+    return buf;
+}
+
+/**
+ * @brief Format a memory size for messages
+ * @param bytes Size in bytes
+ * @return Whole MiB rounded up, or bytes below 1 MiB
+ */
+static string formatBytes(size_t bytes) {
+    const size_t mib = size_t(1) << 20;
+    if (bytes < mib)
+        return to_string(bytes) + " bytes";
+    return to_string((bytes + mib - 1) / mib) + " MiB";
+}
+
+/**
+ * @brief Bytes of the in-memory graph of a network
+ * @param numNodes Node count
+ * @param numArcs Arc count
+ * @return Size of a FlowGraph: arc endpoints and costs plus both CSR
+ *         adjacencies
+ *
+ * Every graph check and every backend needs at least this much memory, so
+ * it decides whether they can run on a network whose edges are stored.
+ */
+static size_t graphBytes(int numNodes, size_t numArcs) {
+    const size_t perArc = 2 * sizeof(int) + sizeof(double) + 2 * sizeof(size_t);
+    const size_t perNode = 2 * sizeof(size_t);
+    return numArcs * perArc + (static_cast<size_t>(numNodes) + 1) * perNode;
+}
+
+/**
+ * @brief Check whether the network passed validation
+ * @return True if no issue is an error; warnings are allowed
+ */
+bool ValidationReport::valid() const {
+    return std::none_of(issues.begin(), issues.end(),
+                        [](const ValidationIssue &i) {
+                            return i.severity() == ValidationSeverity::Error;
+                        });
+}
+
+/**
+ * @brief Count issues of one kind
+ * @param code Issue kind
+ * @return Number of issues with that code
+ */
+size_t ValidationReport::count(ValidationCode code) const {
+    return static_cast<size_t>(
+        std::count_if(issues.begin(), issues.end(),
+                      [code](const ValidationIssue &i) { return i.code == code; }));
+}
+
+/**
+ * @brief Describe the report in text
+ * @param maxIssues Maximum number of issues listed individually
+ * @return "valid", or one line per issue followed by a count of the rest
+ */
+string ValidationReport::summary(size_t maxIssues) const {
+    if (issues.empty())
+        return "valid";
+
+    string text;
+    size_t shown = std::min(maxIssues, issues.size());
+    for (size_t i = 0; i < shown; ++i) {
+        if (i > 0)
+            text += '\n';
+        text += issues[i].message;
+    }
+    if (shown < issues.size())
+        text += "\n... and " + to_string(issues.size() - shown) + " more";
+    return text;
 }
 
 /**
  * @brief Validate the network configuration
- * @return "valid" if network is properly configured, error message otherwise
- * 
- * Performs validation checks on the network:
- * - Verifies that supply and demand are balanced
- * - Checks that all edge endpoints are valid node indices
- * 
+ * @param threads Worker threads, 0 for hardware concurrency
+ * @return Report listing every problem found
+ *
+ * Collects all problems instead of stopping at the first one:
+ * - supply and demand imbalance, with the net amount
+ * - edges whose cost is not finite
+ * - supply nodes without outgoing and demand nodes without incoming edges
+ * - parallel edges between the same pair of nodes, as warnings
+ * - a negative cost cycle, which makes the problem unbounded
+ *
+ * Costs and node degrees are checked in one parallel sweep over the edges,
+ * which stays within the memory budget of stored edges. Node indices of
+ * edges are not rechecked since addEdge() and the edge store constructor
+ * already reject them. The parallel edge and negative cycle checks need a
+ * CSR view of the graph, about twice the size of the edges; for stored
+ * edges they run only if that view fits the store's memory budget, and a
+ * ChecksSkipped warning says so otherwise. The negative cycle search also
+ * needs all costs to be finite.
+ *
  * This should be called before attempting to solve the network flow problem.
  */
-string NetworkFlow::validate() const {
+ValidationReport NetworkFlow::validate(unsigned threads) const {
+    ValidationReport report;
+    report.imbalance = getImbalance();
     if (!isBalanced()) {
-        return "Supply and demand are not balanced.";
+        report.issues.emplace_back(
+            ValidationCode::Imbalanced, 0, -1, report.imbalance,
+            "Supply and demand are not balanced (net balance " +
+                formatAmount(report.imbalance) + ")");
     }
-    for (const auto &e : edges) {
-        if (e.from < 1 || e.from > numNodes || e.to < 1 || e.to > numNodes) {
-            return "Invalid edge: " + to_string(e.from) + "->" +
-                   to_string(e.to);
+
+    struct ChunkIssues {
+        vector<ValidationIssue> isolatedSupply;
+        vector<ValidationIssue> isolatedDemand;
+        vector<ValidationIssue> duplicates;
+    };
+
+    // Edge pass: costs must be finite; mark nodes with out and in edges
+    vector<atomic<char>> hasOut(static_cast<size_t>(numNodes));
+    vector<atomic<char>> hasIn(static_cast<size_t>(numNodes));
+    vector<ValidationIssue> invalidEdges;
+    mutex found;
+    sweepEdges(
+        [&](const EdgeBlock &block) {
+            for (size_t i = 0; i < block.count; ++i) {
+                hasOut[block.from[i] - 1].store(1, memory_order_relaxed);
+                hasIn[block.to[i] - 1].store(1, memory_order_relaxed);
+                if (std::isfinite(block.cost[i]))
+                    continue;
+                size_t edge = block.first + i;
+                lock_guard<mutex> lock(found);
+                invalidEdges.emplace_back(
+                    ValidationCode::InvalidEdge, 0,
+                    static_cast<long long>(edge), 0.0,
+                    "Edge " + to_string(edge) + " (" +
+                        to_string(block.from[i]) + "->" +
+                        to_string(block.to[i]) + ") has a non-finite cost");
+            }
+        },
+        threads);
+    sort(invalidEdges.begin(), invalidEdges.end(),
+         [](const ValidationIssue &a, const ValidationIssue &b) {
+             return a.edge < b.edge;
+         });
+
+    // Node pass: isolated supply/demand nodes
+    vector<ChunkIssues> nodeChunks(workerCount(threads));
+    size_t used = parallelChunks(
+        static_cast<size_t>(numNodes), size_t(1) << 13, threads,
+        [&](size_t c, size_t begin, size_t end) {
+            ChunkIssues &out = nodeChunks[c];
+            for (size_t v = begin; v < end; ++v) {
+                int node = static_cast<int>(v) + 1;
+                if (balances[v] > 0 && !hasOut[v].load(memory_order_relaxed))
+                    out.isolatedSupply.emplace_back(
+                        ValidationCode::IsolatedSupply, node, -1, balances[v],
+                        "Supply node " + to_string(node) +
+                            " has no outgoing edges");
+                if (balances[v] < 0 && !hasIn[v].load(memory_order_relaxed))
+                    out.isolatedDemand.emplace_back(
+                        ValidationCode::IsolatedDemand, node, -1, balances[v],
+                        "Demand node " + to_string(node) +
+                            " has no incoming edges");
+            }
+        });
+    nodeChunks.resize(used);
+
+    auto append = [&](vector<ChunkIssues> &chunks,
+                      vector<ValidationIssue> ChunkIssues::*list) {
+        for (auto &chunk : chunks)
+            for (auto &issue : chunk.*list)
+                report.issues.push_back(std::move(issue));
+    };
+    for (auto &issue : invalidEdges)
+        report.issues.push_back(std::move(issue));
+    append(nodeChunks, &ChunkIssues::isolatedSupply);
+    append(nodeChunks, &ChunkIssues::isolatedDemand);
+    if (store && graphBytes(numNodes, store->size()) > store->memoryBudget()) {
+        report.issues.emplace_back(
+            ValidationCode::ChecksSkipped, 0, -1, 0.0,
+            "Parallel edge and negative cycle checks skipped: the graph "
+            "needs " +
+                formatBytes(graphBytes(numNodes, store->size())) +
+                ", more than the memory budget of " +
+                formatBytes(store->memoryBudget()));
+        return report;
+    }
+
+    // Graph checks: parallel arcs and negative cycles
+    FlowGraph g(*this, threads);
+    vector<ChunkIssues> arcChunks(workerCount(threads));
+    used = parallelChunks(
+        static_cast<size_t>(numNodes), size_t(1) << 13, threads,
+        [&](size_t c, size_t begin, size_t end) {
+            ChunkIssues &out = arcChunks[c];
+            vector<pair<int, size_t>> targets;
+            for (size_t v = begin; v < end; ++v) {
+                int node = static_cast<int>(v) + 1;
+                targets.clear();
+                for (size_t i = g.outBegin[v]; i < g.outBegin[v + 1]; ++i)
+                    targets.emplace_back(g.target[g.outArcs[i]], g.outArcs[i]);
+                sort(targets.begin(), targets.end());
+                for (size_t i = 1; i < targets.size(); ++i) {
+                    if (targets[i].first != targets[i - 1].first)
+                        continue;
+                    size_t a = targets[i].second;
+                    out.duplicates.emplace_back(
+                        ValidationCode::DuplicateArc, node,
+                        static_cast<long long>(a), 0.0,
+                        "Edge " + to_string(a) + " duplicates arc " +
+                            to_string(node) + "->" +
+                            to_string(targets[i].first + 1));
+                }
+            }
+        });
+    arcChunks.resize(used);
+
+    if (report.count(ValidationCode::InvalidEdge) == 0) {
+        vector<size_t> cycle = findNegativeCycle(g, threads);
+        if (!cycle.empty()) {
+            double cycleCost = 0.0;
+            string path = to_string(g.source[cycle.front()] + 1);
+            for (size_t a : cycle) {
+                cycleCost += g.cost[a];
+                path += "->" + to_string(g.target[a] + 1);
+            }
+            report.issues.emplace_back(
+                ValidationCode::NegativeCycle, g.source[cycle.front()] + 1,
+                static_cast<long long>(cycle.front()), cycleCost,
+                "Negative cycle of cost " + formatAmount(cycleCost) + ": " +
+                    path);
+        }
+    }
+
+    size_t firstDuplicate = report.issues.size();
+    append(arcChunks, &ChunkIssues::duplicates);
+    sort(report.issues.begin() + firstDuplicate, report.issues.end(),
+         [](const ValidationIssue &a, const ValidationIssue &b) {
+             return a.edge < b.edge;
+         });
+
+    return report;
+}
+
+/**
+ * @brief Solve the minimum cost network flow problem with CPLEX
+ * @return Solution object containing results and status information
+ */
+Solution NetworkFlow::solve() const { return solve(SolveOptions()); }
+
+/// Backend label of solves answered by the forest shortcut
+static const char *const TREE_SHORTCUT = "tree";
+
+/**
+ * @brief Name of a backend as shown in traces and metrics
+ * @param backend Backend to name
+ * @return Static string naming the backend
+ */
+static const char *backendName(SolverBackend backend) {
+    switch (backend) {
+    case SolverBackend::Relaxation:
+        return "relaxation";
+    case SolverBackend::CapacityScaling:
+        return "capacity scaling";
+    case SolverBackend::CycleCanceling:
+        return "cycle canceling";
+    case SolverBackend::Transportation:
+        return "transportation";
+    case SolverBackend::NetworkSimplex:
+        return "network simplex";
+    case SolverBackend::Cplex:
+        break;
+    }
+    return "cplex";
+}
+
+/**
+ * @class SolveMetrics
+ * @brief Metrics recorded for every solve() call, registered once
+ *
+ * The series of all backends are looked up at first use, so recording a
+ * solve only adds to atomics.
+ */
+class SolveMetrics {
+private:
+    static constexpr size_t OUTCOMES = 4;
+
+    struct Route {
+        const char *backend;
+        MetricCounter *solves[OUTCOMES];
+        MetricHistogram *seconds;
+    };
+
+    std::vector<Route> routes;
+    MetricHistogram &nodes;
+    MetricHistogram &edges;
+
+    static size_t outcome(const Solution &result) {
+        if (result.solved)
+            return 0;
+        if (result.status == "Infeasible")
+            return 1;
+        if (result.status == "Unbounded")
+            return 2;
+        return 3;
+    }
+
+public:
+    SolveMetrics()
+        : nodes(Metrics::histogram("networkflow_solve_nodes",
+                                   "Nodes of solved networks", 1.0)),
+          edges(Metrics::histogram("networkflow_solve_edges",
+                                   "Edges of solved networks", 1.0)) {
+        static const char *const OUTCOME_NAMES[OUTCOMES] = {
+            "optimal", "infeasible", "unbounded", "error"};
+        std::vector<const char *> backends = {TREE_SHORTCUT};
+        for (SolverBackend b :
+             {SolverBackend::Cplex, SolverBackend::Relaxation,
+              SolverBackend::CapacityScaling, SolverBackend::CycleCanceling,
+              SolverBackend::Transportation, SolverBackend::NetworkSimplex})
+            backends.push_back(backendName(b));
+        for (const char *backend : backends) {
+            Route route;
+            route.backend = backend;
+            for (size_t k = 0; k < OUTCOMES; ++k)
+                route.solves[k] = &Metrics::counter(
+                    "networkflow_solves_total", "Calls of solve()",
+                    {{"backend", backend}, {"outcome", OUTCOME_NAMES[k]}});
+            route.seconds = &Metrics::histogram(
+                "networkflow_solve_seconds", "Wall time of solve()", 1e-9,
+                {{"backend", backend}});
+            routes.push_back(route);
+        }
+    }
+
+    /**
+     * @brief Record one call
+     * @param net Network that was solved
+     * @param backend Backend that answered, as named by backendName()
+     * @param result Solution returned
+     * @param nanoseconds Wall time of the call
+     */
+    void record(const NetworkFlow &net, const char *backend,
+                const Solution &result, uint64_t nanoseconds) {
+        nodes.record(static_cast<uint64_t>(max(net.getNumNodes(), 0)));
+        edges.record(net.getNumEdges());
+        for (Route &route : routes) {
+            if (strcmp(route.backend, backend) != 0)
+                continue;
+            route.solves[outcome(result)]->add();
+            route.seconds->record(nanoseconds);
+        }
+    }
+};
+
+/**
+ * @brief Metrics of solve() calls
+ * @return Process-wide instance
+ */
+static SolveMetrics &solveMetrics() {
+    static SolveMetrics metrics;
+    return metrics;
+}
+
+/// solve() calls running on this thread; backends may solve subproblems
+static thread_local int solveDepth = 0;
+
+/**
+ * @brief Solve the minimum cost network flow problem
+ * @param options Backend selection and warm-start data
+ * @return Solution object containing results and status information
+ *
+ * Dispatches to the selected backend. Exceptions thrown by native engines
+ * are reported through the solution status, as for CPLEX.
+ *
+ * Unless SolveOptions::acyclicShortcut is cleared, forests are solved in
+ * closed form and acyclic networks with a single supply node go to the
+ * transportation backend first. Stored edges whose graph does not fit the
+ * store's memory budget get a "Memory budget exceeded" status.
+ *
+ * The algorithmic events counted while solving are returned in
+ * Solution::counters, and while AllocationTracker is on the allocations of
+ * each phase in Solution::allocations. Every call is also recorded in the
+ * metrics registry (see Metrics.hpp) with the backend that answered it,
+ * except subproblems that a backend solves through solve() itself.
+ */
+Solution NetworkFlow::solve(const SolveOptions &options) const {
+    TraceScope trace("solve", "solve", backendName(options.backend));
+    const auto start = chrono::steady_clock::now();
+    const char *backend = backendName(options.backend);
+    Solution result;
+    {
+        CounterScope counting;
+        AllocationScope allocating;
+        ++solveDepth;
+        result = solveWithBackend(options, backend);
+        --solveDepth;
+        result.counters = counting.get();
+        result.allocations = allocating.report();
+    }
+    if (solveDepth == 0) {
+        const auto elapsed = chrono::duration_cast<chrono::nanoseconds>(
+            chrono::steady_clock::now() - start);
+        solveMetrics().record(*this, backend, result,
+                              static_cast<uint64_t>(elapsed.count()));
+    }
+    return result;
+}
+
+/**
+ * @brief Run the shortcuts and the selected backend
+ * @param options Backend selection and warm-start data
+ * @param backend Set to the name of the shortcut that answered, if any
+ * @return Solution object containing results and status information
+ *
+ * Every backend holds the graph and the edge flows in memory. For stored
+ * edges that do not fit the store's memory budget that way, the solve
+ * fails up front with a status naming both sizes instead of running into
+ * bad_alloc.
+ */
+Solution NetworkFlow::solveWithBackend(const SolveOptions &options,
+                                       const char *&backend) const {
+    if (store) {
+        const size_t needed = graphBytes(numNodes, store->size()) +
+                              store->size() * sizeof(double);
+        if (needed > store->memoryBudget()) {
+            Solution result;
+            result.status = "Memory budget exceeded: solving needs " +
+                            formatBytes(needed) +
+                            " for the graph and flows, the budget is " +
+                            formatBytes(store->memoryBudget());
+            return result;
+        }
+    }
+    try {
+        if (options.acyclicShortcut) {
+            Solution shortcut;
+            if (TreeSolver(*this).solve(options, shortcut)) {
+                backend = TREE_SHORTCUT;
+                return shortcut;
+            }
+            if (options.backend != SolverBackend::Transportation &&
+                TransportationSolver::linearOnAcyclic(*this,
+                                                      options.threads)) {
+                shortcut = TransportationSolver(*this).solve(options);
+                if (shortcut.solved) {
+                    backend = backendName(SolverBackend::Transportation);
+                    return shortcut;
+                }
+            }
+        }
+        switch (options.backend) {
+        case SolverBackend::Relaxation:
+            return RelaxationSolver(*this).solve(options);
+        case SolverBackend::CapacityScaling:
+            return CapacityScalingSolver(*this).solve(options);
+        case SolverBackend::CycleCanceling:
+            return CycleCancelingSolver(*this).solve(options);
+        case SolverBackend::Transportation:
+            return TransportationSolver(*this).solve(options);
+        case SolverBackend::NetworkSimplex:
+            return NetworkSimplexSolver(*this).solve(options);
+        case SolverBackend::Cplex:
+            break;
         }
+    } catch (const std::exception &ex) {
+        Solution result;
+        result.status = "STD Exception: " + string(ex.what());
+        return result;
     }
-    return "valid";
+    const SimplexBasis *basis = options.initialBasis.get();
+    return solveWithCplex(basis && basis->matches(*this) ? basis : nullptr);
+}
+
+/**
+ * @brief CPLEX basis statuses marking listed indices as basic
+ * @param env CPLEX environment
+ * @param basic Basic indices in increasing order
+ * @param count Number of variables or rows
+ * @return Basic for the listed indices, AtLower for the others
+ */
+template <typename Index>
+static IloCplex::BasisStatusArray
+basisStatuses(IloEnv env, const vector<Index> &basic, size_t count) {
+    IloCplex::BasisStatusArray status(env);
+    size_t next = 0;
+    for (size_t i = 0; i < count; ++i) {
+        bool isBasic =
+            next < basic.size() && static_cast<size_t>(basic[next]) == i;
+        next += isBasic ? 1 : 0;
+        status.add(isBasic ? IloCplex::Basic : IloCplex::AtLower);
+    }
+    return status;
+}
+
+/**
+ * @brief Read the optimal basis of a solved model
+ * @param net Network the model was built from
+ * @param env CPLEX environment
+ * @param cplex Solved model
+ * @param vars Edge variables in edge order
+ * @param rows Conservation rows in node order
+ * @return Basis, or null if CPLEX has none (e.g. barrier without crossover)
+ */
+static shared_ptr<const SimplexBasis>
+optimalBasis(const NetworkFlow &net, IloEnv env, const IloCplex &cplex,
+             const IloNumVarArray &vars, const IloRangeArray &rows) {
+    IloCplex::BasisStatusArray columnStatus(env), rowStatus(env);
+    try {
+        cplex.getBasisStatuses(columnStatus, vars, rowStatus, rows);
+    } catch (const IloException &) {
+        return nullptr;
+    }
+
+    vector<size_t> edges;
+    vector<int> roots;
+    for (IloInt i = 0; i < columnStatus.getSize(); ++i)
+        if (columnStatus[i] == IloCplex::Basic)
+            edges.push_back(static_cast<size_t>(i));
+    for (IloInt i = 0; i < rowStatus.getSize(); ++i)
+        if (rowStatus[i] == IloCplex::Basic)
+            roots.push_back(static_cast<int>(i));
+    if (edges.size() + roots.size() != static_cast<size_t>(net.getNumNodes()))
+        return nullptr;
+    return make_shared<const SimplexBasis>(net, std::move(edges),
+                                           std::move(roots));
 }
 
 /**
  * @brief Solve the minimum cost network flow problem using CPLEX
+ * @param initialBasis Basis to start from, null for a cold start
  * @return Solution object containing results and status information
  * 
  * Formulates and solves the minimum cost flow problem as a linear program:
@@ -138,71 +854,124 @@ string NetworkFlow::validate() const {
  * - c_ij = cost per unit flow on edge (i,j)
  * - b_i = balance at node i (supply if positive, demand if negative)
  * 
+ * The model is built column-wise: each variable is created with its
+ * objective coefficient and its entries in the two conservation rows, so
+ * construction is linear in the network size and needs no expression
+ * temporaries. Handle arrays live in a per-solve arena, and the model is
+ * extracted into CPLEX only once it is complete. Flows and duals (the
+ * node potentials) are copied out with one bulk call each.
+ *
  * @note Assumes unlimited edge capacities
  * @note Properly manages CPLEX environment to prevent memory leaks
  * @throws Handles CPLEX and standard exceptions internally
  */
-Solution NetworkFlow::solve() const {
+Solution NetworkFlow::solveWithCplex(const SimplexBasis *initialBasis) const {
     IloEnv env;
     Solution result;
+    SolveArena arena((numNodes + 1) * sizeof(IloRange) +
+                     getNumEdges() * sizeof(IloNumVar));
     
     try {
+        TraceScope buildTrace("build model");
         IloModel model(env, "MinimumCostFlow");
-        IloCplex cplex(model);
-        
-        cplex.setOut(env.getNullStream());
-        cplex.setWarning(env.getNullStream());
 
-        // Map: (from, to) -> variable
-        map<pair<int, int>, IloNumVar> edgeVars;
-
-        // Create variables and build objective function
-        IloExpr totalCost(env);
-        for (const auto &e : edges) {
-            IloNumVar var(env, 0, IloInfinity, ILOFLOAT);
-            string name = "x_" + to_string(e.from) + "_" + to_string(e.to);
-            var.setName(name.c_str());
-            edgeVars[{e.from, e.to}] = var;
-            totalCost += e.cost * var;
-            model.add(var);
-        }
-        
-        // Add objective
-        model.add(IloMinimize(env, totalCost));
-
-        // Flow conservation constraints
+        // Objective and flow conservation rows: inflow - outflow = -b_i
+        IloObjective totalCost = IloMinimize(env);
+        model.add(totalCost);
+        ArenaVector<IloRange> conservation = arena.vector<IloRange>();
+        conservation.reserve(numNodes);
         for (int node = 1; node <= numNodes; ++node) {
-            IloExpr netFlow(env);
             double supply = getBalance(node); // b_i
+            conservation.emplace_back(env, -supply, -supply);
+            model.add(conservation.back());
+        }
 
-            // Sum of inflow - outflow = -b_i
-            for (const auto &e : edges) {
-                if (e.to == node) {
-                    netFlow += edgeVars.at({e.from, e.to});
-                }
-                if (e.from == node) {
-                    netFlow -= edgeVars.at({e.from, e.to});
+        // One variable per edge, created from its column
+        ArenaVector<IloNumVar> edgeVars = arena.vector<IloNumVar>();
+        edgeVars.reserve(getNumEdges());
+        char name[32];
+        sweepEdges([&](const EdgeBlock &block) {
+            for (size_t i = 0; i < block.count; ++i) {
+                IloNumColumn column = totalCost(block.cost[i]);
+                if (block.from[i] != block.to[i]) {
+                    column += conservation[block.to[i] - 1](1.0);
+                    column += conservation[block.from[i] - 1](-1.0);
                 }
+                snprintf(name, sizeof(name), "x_%d_%d", block.from[i],
+                         block.to[i]);
+                edgeVars.emplace_back(column, 0, IloInfinity, ILOFLOAT, name);
+                column.end();
             }
+        });
 
-            model.add(netFlow == -supply);
-            netFlow.end();  // Clean up the expression
-        }
+        // Extract once the model is complete rather than edge by edge
+        IloCplex cplex(env);
+        cplex.setOut(env.getNullStream());
+        cplex.setWarning(env.getNullStream());
+        cplex.extract(model);
 
-        totalCost.end();  // Clean up the objective expression
+        // A basis is a set of basic edges plus the rows whose slack is basic
+        IloNumVarArray vars(env);
+        IloRangeArray rows(env);
+        for (const IloNumVar &var : edgeVars)
+            vars.add(var);
+        for (const IloRange &row : conservation)
+            rows.add(row);
+        if (initialBasis)
+            cplex.setBasisStatuses(basisStatuses(env, initialBasis->edges(),
+                                                 edgeVars.size()),
+                                   vars,
+                                   basisStatuses(env,
+                                                 initialBasis->rootNodes(),
+                                                 conservation.size()),
+                                   rows);
+        buildTrace.finish();
 
         // Solve
-        if (cplex.solve()) {
+        TraceScope solveTrace("cplex solve");
+        bool solved = cplex.solve();
+        solveTrace.finish();
+        EventCounters::add(Counter::Pivots,
+                           static_cast<uint64_t>(cplex.getNiterations()));
+        if (solved) {
+            TraceScope extractTrace("extract");
             result.solved = true;
             result.totalCost = cplex.getObjValue();
             result.status = "Optimal";
 
-            for (const auto &e : edges) {
-                double flow = cplex.getValue(edgeVars.at({e.from, e.to}));
-                if (flow > 1e-6) {
-                    result.flows[{e.from, e.to}] = flow;
-                }
+            // One bulk call per array instead of one call per edge
+            const size_t m = edgeVars.size();
+            IloNumArray values(env, static_cast<IloInt>(m));
+            IloNumArray duals(env, numNodes);
+            cplex.getValues(values, vars);
+            cplex.getDuals(duals, rows);
+            result.edgeFlows.resize(m);
+            for (size_t e = 0; e < m; ++e)
+                result.edgeFlows[e] = values[static_cast<IloInt>(e)];
+            result.potentials.resize(numNodes);
+            for (int v = 0; v < numNodes; ++v)
+                result.potentials[v] = duals[v];
+
+            // Edges that carry flow, found without branching per edge
+            vector<size_t> used(m);
+            size_t count = 0;
+            for (size_t e = 0; e < m; ++e) {
+                used[count] = e;
+                count += result.edgeFlows[e] > 1e-6 ? 1 : 0;
             }
+            used.resize(count);
+
+            // Look up their endpoints in one ordered sweep
+            size_t next = 0;
+            sweepEdges([&](const EdgeBlock &block) {
+                const size_t end = block.first + block.count;
+                for (; next < count && used[next] < end; ++next) {
+                    size_t i = used[next] - block.first;
+                    result.flows[{block.from[i], block.to[i]}] +=
+                        result.edgeFlows[used[next]];
+                }
+            });
+            result.basis = optimalBasis(*this, env, cplex, vars, rows);
         } else {
             result.status = "No solution found";
             if (cplex.getStatus() == IloAlgorithm::Infeasible)
@@ -0,0 +1,821 @@
+/**
+ * @file NetworkSimplexSolver.cpp
+ * @brief Implementation of the primal network simplex solver
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ *
+ * Notation: node n is the root; arc m + v is the artificial arc between
+ * node v and the root. Every non-root node x hangs from parent[x] by the
+ * tree arc pred[x], which points up (x -> parent) or down (parent -> x) as
+ * given by dir[x]. Arcs outside the tree carry no flow, since arcs have no
+ * upper bound, and tree arcs have zero reduced cost.
+ *
+ * The tree is stored as in LEMON: besides parent and pred, every node has
+ * its successor in a preorder walk of the tree (thread, with revThread as
+ * the inverse), the size of its subtree (succNum) and the last node of its
+ * subtree in thread order (lastSucc). Subtrees are then contiguous thread
+ * segments, so finding the pivot cycle walks only the two paths up to the
+ * apex, and a pivot rewires the moved subtree and shifts its potentials in
+ * time proportional to its size rather than to the number of nodes.
+ *
+ * The tree is kept strongly feasible: every tree arc pointing down carries
+ * positive flow, so some flow can always be sent from any node up to the
+ * root. Choosing the leaving arc as below preserves this and rules out
+ * cycling on degenerate pivots (Cunningham).
+ *
+ * A stored basis is installed the same way as the all-artificial starting
+ * tree: flows follow from the balances, and arcs whose flow would break
+ * strong feasibility give way to artificial arcs, which later pivots
+ * drive out again.
+ */
+
+#include "NetworkSimplexSolver.hpp"
+#include "Counters.hpp"
+#include "NativeSolver.hpp"
+#include "Parallel.hpp"
+#include "Pricing.hpp"
+#include "ShortestPath.hpp"
+#include "SimplexBasis.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <numeric>
+
+using namespace std;
+
+namespace {
+
+constexpr long long INF = numeric_limits<long long>::max();
+
+/// Largest artificial arc cost; keeps potentials and reduced costs in range
+constexpr long long MAX_ARTIFICIAL_COST = 1LL << 60;
+
+constexpr signed char UP = 1;
+constexpr signed char DOWN = -1;
+
+/// Block size factor and lower bound (block size ~ sqrt(m))
+constexpr double BLOCK_SIZE_FACTOR = 1.0;
+constexpr size_t MIN_BLOCK_SIZE = 10;
+
+/// Candidate list length and minor iteration limit factors and bounds
+constexpr double LIST_LENGTH_FACTOR = 0.25;
+constexpr size_t MIN_LIST_LENGTH = 10;
+constexpr double MINOR_LIMIT_FACTOR = 0.1;
+constexpr size_t MIN_MINOR_LIMIT = 3;
+
+/// Fewest arcs a pricing worker scans per step, so that a step outweighs
+/// waking the workers (a few microseconds)
+constexpr size_t MIN_PARALLEL_CHUNK = 1 << 15;
+
+/**
+ * @class EnteringArc
+ * @brief Pricing of the real arcs by the selected rule
+ *
+ * Arcs are scanned cyclically one pricing block per step, whatever the
+ * number of threads. A block large enough to give every worker at least
+ * MIN_PARALLEL_CHUNK arcs is split into one chunk per worker, and the best
+ * of the step is taken, in worker order on ties, so the result does not
+ * depend on timing. Pivots stay sequential.
+ */
+class EnteringArc {
+private:
+    /**
+     * @struct WorkerScan
+     * @brief What one worker found in its chunk, on its own cache line
+     */
+    struct alignas(64) WorkerScan {
+        ArcPrice best;
+        vector<ArcPrice> negative; ///< Candidate list rule only
+        vector<long long> reduced;
+    };
+
+    const PricingArcs arcs;
+    const size_t m;
+    const PricingRule rule;
+    const size_t blockSize; ///< Arcs per step
+    size_t chunk;           ///< Arcs per worker and step
+    size_t next;  ///< Arc where the next scan starts
+
+    WorkerPool pool;
+    vector<WorkerScan> scans;
+
+    // Candidate list rule
+    size_t listLength;
+    size_t minorLimit;
+    size_t minorCount;
+    vector<size_t> list;
+    vector<long long> reduced;
+
+    /**
+     * @brief Arcs priced per step
+     * @param numArcs Number of real arcs
+     * @return About sqrt(numArcs), at least MIN_BLOCK_SIZE
+     */
+    static size_t pricingBlock(size_t numArcs) {
+        double root = std::sqrt(static_cast<double>(numArcs));
+        return max(static_cast<size_t>(BLOCK_SIZE_FACTOR * root),
+                   MIN_BLOCK_SIZE);
+    }
+
+    /**
+     * @brief Workers worth running for one block
+     * @param block Arcs priced per step
+     * @param threads Requested threads, 0 for hardware concurrency
+     * @return 1 unless every worker gets at least MIN_PARALLEL_CHUNK arcs
+     */
+    static unsigned pricingWorkers(size_t block, unsigned threads) {
+        size_t workers =
+            min<size_t>(workerCount(threads), block / MIN_PARALLEL_CHUNK);
+        return static_cast<unsigned>(max<size_t>(workers, 1));
+    }
+
+    /**
+     * @brief Call fn(begin, end) on the one or two pieces of a cyclic range
+     * @param begin First arc
+     * @param count Number of arcs, at most m
+     * @param fn Callable taking a half-open arc range
+     */
+    template <typename F> void pieces(size_t begin, size_t count, F &&fn) {
+        size_t end = begin + count;
+        if (end <= m) {
+            fn(begin, end);
+        } else {
+            fn(begin, m);
+            fn(0, end - m);
+        }
+    }
+
+    /**
+     * @brief Run fn(worker, begin, end) on every worker's part of a step
+     * @param span Arcs in the step, starting at next
+     * @param fn Callable taking the worker index and a half-open arc range
+     */
+    template <typename F> void scanStep(size_t span, F &&fn) {
+        const size_t start = next;
+        pool.run([&](unsigned w) {
+            size_t first = w * chunk;
+            if (first >= span)
+                return;
+            pieces((start + first) % m, min(chunk, span - first),
+                   [&](size_t b, size_t e) { fn(w, b, e); });
+        });
+        next = (start + span) % m;
+    }
+
+    /**
+     * @brief Scan steps until one holds an arc with negative reduced cost
+     * @return Best arc of that step, or NO_ARC after a full round
+     */
+    size_t block() {
+        for (size_t scanned = 0; scanned < m;) {
+            size_t span = min(m - scanned, blockSize);
+            for (auto &scan : scans)
+                scan.best = {0, NO_ARC};
+            scanStep(span, [&](unsigned w, size_t b, size_t e) {
+                ArcPrice found = priceRange(arcs, b, e);
+                if (found.reduced < scans[w].best.reduced)
+                    scans[w].best = found;
+            });
+            scanned += span;
+            EventCounters::add(Counter::ArcsPriced, span);
+
+            ArcPrice best{0, NO_ARC};
+            for (const auto &scan : scans)
+                if (scan.best.reduced < best.reduced)
+                    best = scan.best;
+            if (best.arc != NO_ARC)
+                return best.arc;
+        }
+        return NO_ARC;
+    }
+
+    /**
+     * @brief Pick the best listed arc, refilling the list when it runs dry
+     * @return Entering arc, or NO_ARC if no arc has negative reduced cost
+     */
+    size_t candidateList() {
+        if (!list.empty() && minorCount < minorLimit) {
+            ++minorCount;
+            reduced.resize(list.size());
+            listReducedCosts(arcs, list.data(), list.size(), reduced.data());
+            EventCounters::add(Counter::ArcsPriced, list.size());
+            size_t kept = 0, best = NO_ARC;
+            long long lowest = 0;
+            for (size_t i = 0; i < list.size(); ++i) {
+                if (reduced[i] >= 0)
+                    continue;
+                if (reduced[i] < lowest) {
+                    lowest = reduced[i];
+                    best = list[i];
+                }
+                list[kept++] = list[i];
+            }
+            list.resize(kept);
+            if (best != NO_ARC)
+                return best;
+        }
+
+        // Major iteration: collect fresh candidates step by step
+        minorCount = 0;
+        list.clear();
+        size_t best = NO_ARC;
+        long long lowest = 0;
+        for (size_t scanned = 0; scanned < m && list.size() < listLength;) {
+            size_t span = min(m - scanned, blockSize);
+            for (auto &scan : scans)
+                scan.negative.clear();
+            scanStep(span, [&](unsigned w, size_t b, size_t e) {
+                WorkerScan &scan = scans[w];
+                scan.reduced.resize(e - b);
+                rangeReducedCosts(arcs, b, e, scan.reduced.data());
+                for (size_t a = b; a < e; ++a)
+                    if (scan.reduced[a - b] < 0)
+                        scan.negative.push_back({scan.reduced[a - b], a});
+            });
+            scanned += span;
+            EventCounters::add(Counter::ArcsPriced, span);
+
+            for (const auto &scan : scans) {
+                for (const ArcPrice &candidate : scan.negative) {
+                    list.push_back(candidate.arc);
+                    if (candidate.reduced < lowest) {
+                        lowest = candidate.reduced;
+                        best = candidate.arc;
+                    }
+                }
+            }
+        }
+        return best;
+    }
+
+public:
+    /**
+     * @brief Set up pricing
+     * @param pricing Arcs and potentials, read again on every call to find
+     * @param numArcs Number of real arcs to price
+     * @param pricingRule Pricing rule
+     * @param threads Requested threads, 0 for hardware concurrency
+     */
+    EnteringArc(const PricingArcs &pricing, size_t numArcs,
+                PricingRule pricingRule, unsigned threads)
+        : arcs(pricing), m(numArcs), rule(pricingRule),
+          blockSize(pricingBlock(numArcs)), next(0),
+          pool(pricingWorkers(blockSize, threads)), scans(pool.size()),
+          minorCount(0) {
+        chunk = (blockSize + pool.size() - 1) / pool.size();
+        double root = std::sqrt(static_cast<double>(m));
+        listLength = max(static_cast<size_t>(LIST_LENGTH_FACTOR * root),
+                         MIN_LIST_LENGTH);
+        minorLimit = max(static_cast<size_t>(
+                             MINOR_LIMIT_FACTOR *
+                             std::sqrt(static_cast<double>(listLength))),
+                         MIN_MINOR_LIMIT);
+    }
+
+    /**
+     * @brief Choose the next entering arc
+     * @return Arc with negative reduced cost, or NO_ARC at optimality
+     */
+    size_t find() {
+        if (m == 0)
+            return NO_ARC;
+        return rule == PricingRule::CandidateList ? candidateList() : block();
+    }
+};
+
+/**
+ * @class NetworkSimplex
+ * @brief State of one network simplex solve
+ */
+class NetworkSimplex {
+private:
+    const int n;    ///< Real nodes; node n is the root
+    const size_t m; ///< Real arcs; arcs m .. m + n - 1 are artificial
+    const int root;
+
+    ArenaVector<int> source;
+    ArenaVector<int> target;
+    ArenaVector<long long> cost;
+
+    // Spanning tree: thread is the preorder successor, cyclic through the
+    // root, so a subtree is the thread segment from its root to lastSucc
+    ArenaVector<int> parent;
+    ArenaVector<size_t> pred;
+    ArenaVector<signed char> dir;
+    ArenaVector<int> thread;
+    ArenaVector<int> revThread;
+    ArenaVector<int> succNum;  ///< Subtree size
+    ArenaVector<int> lastSucc; ///< Last subtree node in thread order
+    vector<int> dirtyRevs;
+
+    /**
+     * @brief Find the apex of the cycle closed by an arc
+     * @param u One end
+     * @param v Other end
+     * @return Deepest common ancestor of u and v
+     *
+     * A subtree is smaller than any subtree containing it, so stepping up
+     * from the end with the smaller subtree only visits the two paths.
+     */
+    int join(int u, int v) const {
+        while (u != v) {
+            if (succNum[u] < succNum[v])
+                u = parent[u];
+            else
+                v = parent[v];
+        }
+        return u;
+    }
+
+    /**
+     * @brief Swap the leaving tree arc for the entering one
+     * @param in Entering arc
+     * @param uIn End of the entering arc inside the subtree that moves
+     * @param vIn Other end, the new parent of uIn
+     * @param uOut Node below the leaving arc
+     * @param apex Apex of the pivot cycle
+     *
+     * The subtree below the leaving arc is re-rooted at uIn and hung from
+     * vIn. Only the stem (the path from uIn up to uOut), the moved subtree
+     * and the two paths up to the apex are touched.
+     */
+    void updateTree(size_t in, int uIn, int vIn, int uOut, int apex) {
+        const int oldRevThread = revThread[uOut];
+        const int oldSuccNum = succNum[uOut];
+        const int oldLastSucc = lastSucc[uOut];
+        const int vOut = parent[uOut];
+        const signed char dirIn = uIn == source[in] ? UP : DOWN;
+
+        if (uIn == uOut) {
+            parent[uIn] = vIn;
+            pred[uIn] = in;
+            dir[uIn] = dirIn;
+
+            // Move the subtree's thread segment to right after vIn
+            if (thread[vIn] != uOut) {
+                int after = thread[oldLastSucc];
+                thread[oldRevThread] = after;
+                revThread[after] = oldRevThread;
+                after = thread[vIn];
+                thread[vIn] = uOut;
+                revThread[uOut] = vIn;
+                thread[oldLastSucc] = after;
+                revThread[after] = oldLastSucc;
+            }
+        } else {
+            // If the subtree directly follows vIn, vOut is the apex and
+            // the thread continues after the subtree
+            const int threadContinue =
+                oldRevThread == vIn ? thread[oldLastSucc] : thread[vIn];
+
+            // Walk up the stem, splicing each stem node's remaining
+            // subtree after the previous one and reversing parents
+            int stem = uIn, parentStem = vIn;
+            int last = lastSucc[uIn];
+            int after = thread[last];
+            thread[vIn] = uIn;
+            dirtyRevs.clear();
+            dirtyRevs.push_back(vIn);
+            while (stem != uOut) {
+                const int nextStem = parent[stem];
+                thread[last] = nextStem;
+                dirtyRevs.push_back(last);
+
+                const int before = revThread[stem];
+                thread[before] = after;
+                revThread[after] = before;
+
+                parent[stem] = parentStem;
+                parentStem = stem;
+                stem = nextStem;
+
+                last = lastSucc[stem] == lastSucc[parentStem]
+                           ? revThread[parentStem]
+                           : lastSucc[stem];
+                after = thread[last];
+            }
+            parent[uOut] = parentStem;
+            thread[last] = threadContinue;
+            revThread[threadContinue] = last;
+            lastSucc[uOut] = last;
+
+            if (oldRevThread != vIn) {
+                thread[oldRevThread] = after;
+                revThread[after] = oldRevThread;
+            }
+            for (int x : dirtyRevs)
+                revThread[thread[x]] = x;
+
+            // Shift tree arcs, sizes and last successors along the stem
+            int size = 0;
+            const int stemLast = lastSucc[uOut];
+            for (int x = uOut, p = parent[x]; x != uIn;
+                 x = p, p = parent[x]) {
+                pred[x] = pred[p];
+                dir[x] = static_cast<signed char>(-dir[p]);
+                size += succNum[x] - succNum[p];
+                succNum[x] = size;
+                lastSucc[p] = stemLast;
+            }
+            pred[uIn] = in;
+            dir[uIn] = dirIn;
+            succNum[uIn] = oldSuccNum;
+        }
+
+        // Last successors on the paths from vIn and vOut up to the apex
+        const int limit = lastSucc[apex] == vIn ? apex : -1;
+        const int movedLast = lastSucc[uOut];
+        for (int x = vIn; x != -1 && lastSucc[x] == vIn; x = parent[x])
+            lastSucc[x] = movedLast;
+        if (apex != oldRevThread && vIn != oldRevThread) {
+            for (int x = vOut; x != limit && lastSucc[x] == oldLastSucc;
+                 x = parent[x])
+                lastSucc[x] = oldRevThread;
+        } else if (movedLast != oldLastSucc) {
+            for (int x = vOut; x != limit && lastSucc[x] == oldLastSucc;
+                 x = parent[x])
+                lastSucc[x] = movedLast;
+        }
+
+        for (int x = vIn; x != apex; x = parent[x])
+            succNum[x] += oldSuccNum;
+        for (int x = vOut; x != apex; x = parent[x])
+            succNum[x] -= oldSuccNum;
+    }
+
+    /**
+     * @brief Perform one pivot
+     * @param in Entering arc
+     * @return False if the cycle has no arc to block it (unbounded)
+     */
+    bool pivot(size_t in) {
+        const int u = source[in], v = target[in];
+        const int apex = join(u, v);
+
+        // Flow runs apex -> u -> v -> apex. On the u side ties go to the
+        // arc nearest the apex, on the v side to the arc nearest v.
+        long long delta = INF;
+        int out = -1;
+        bool sourceSide = false;
+        for (int x = u; x != apex; x = parent[x]) {
+            if (dir[x] == UP && flow[pred[x]] < delta) {
+                delta = flow[pred[x]];
+                out = x;
+                sourceSide = true;
+            }
+        }
+        for (int x = v; x != apex; x = parent[x]) {
+            if (dir[x] == DOWN && flow[pred[x]] <= delta) {
+                delta = flow[pred[x]];
+                out = x;
+                sourceSide = false;
+            }
+        }
+        if (out < 0)
+            return false;
+
+        EventCounters::add(Counter::Pivots);
+        if (delta == 0)
+            EventCounters::add(Counter::DegeneratePivots);
+        if (delta > 0) {
+            flow[in] += delta;
+            for (int x = u; x != apex; x = parent[x])
+                flow[pred[x]] -= dir[x] * delta;
+            for (int x = v; x != apex; x = parent[x])
+                flow[pred[x]] += dir[x] * delta;
+        }
+
+        // The side that lost its tree arc hangs from the other end
+        const int uIn = sourceSide ? u : v;
+        const int vIn = sourceSide ? v : u;
+        updateTree(in, uIn, vIn, out, apex);
+
+        // Make the entering arc tight by shifting the moved subtree
+        const long long shift = pi[vIn] - dir[uIn] * cost[in] - pi[uIn];
+        const int end = thread[lastSucc[uIn]];
+        for (int x = uIn; x != end; x = thread[x])
+            pi[x] += shift;
+        return true;
+    }
+
+public:
+    ArenaVector<long long> flow;
+    ArenaVector<long long> pi;
+
+    NetworkSimplex(const IntegralInstance &inst, long long artificialCost,
+                   SolveArena &arena)
+        : n(inst.graph.numNodes), m(inst.graph.numArcs()), root(n),
+          source(arena.vector<int>(m + n)), target(arena.vector<int>(m + n)),
+          cost(arena.vector<long long>(m + n, artificialCost)),
+          parent(arena.vector<int>(n + 1)),
+          pred(arena.vector<size_t>(n + 1)),
+          dir(arena.vector<signed char>(n + 1)),
+          thread(arena.vector<int>(n + 1)),
+          revThread(arena.vector<int>(n + 1)),
+          succNum(arena.vector<int>(n + 1)),
+          lastSucc(arena.vector<int>(n + 1)),
+          flow(arena.vector<long long>(m + n)),
+          pi(arena.vector<long long>(n + 1)) {
+        const FlowGraph &g = inst.graph;
+        copy(g.source.begin(), g.source.end(), source.begin());
+        copy(g.target.begin(), g.target.end(), target.begin());
+        copy(inst.cost.begin(), inst.cost.end(), cost.begin());
+    }
+
+    /**
+     * @brief Set up a strongly feasible starting tree
+     * @param supply Supply per node
+     * @param treeArcs Real arcs of the tree
+     * @param rootNodes Nodes joined to the root by their artificial arc
+     * @return False, leaving the state untouched, if the arcs do not form a
+     *         spanning tree with the root
+     *
+     * A cold start passes no real arcs and every node as a root node.
+     * Flows on the tree arcs follow from the subtree balances. A real arc
+     * that would carry negative flow, or zero flow pointing down, is
+     * swapped for the artificial arc of the node below it, so any basis
+     * gives a strongly feasible tree for the current balances.
+     */
+    bool start(const vector<long long> &supply,
+               const vector<size_t> &treeArcs, const vector<int> &rootNodes) {
+        // Tree adjacency, root links as NO_ARC
+        vector<size_t> degree(n + 2, 0);
+        for (size_t a : treeArcs) {
+            if (source[a] == target[a])
+                return false;
+            ++degree[source[a] + 1];
+            ++degree[target[a] + 1];
+        }
+        for (int v : rootNodes) {
+            ++degree[v + 1];
+            ++degree[root + 1];
+        }
+        for (int v = 0; v <= n; ++v)
+            degree[v + 1] += degree[v];
+        vector<size_t> link(degree[n + 1]);
+        vector<int> other(degree[n + 1]);
+        {
+            vector<size_t> slot(degree.begin(), degree.end() - 1);
+            auto add = [&](int x, int y, size_t a) {
+                link[slot[x]] = a;
+                other[slot[x]++] = y;
+            };
+            for (size_t a : treeArcs) {
+                add(source[a], target[a], a);
+                add(target[a], source[a], a);
+            }
+            for (int v : rootNodes) {
+                add(v, root, NO_ARC);
+                add(root, v, NO_ARC);
+            }
+        }
+
+        // Orient the tree from the root, parents before children
+        vector<int> order, up(n + 1, -1);
+        vector<size_t> upArc(n + 1, NO_ARC);
+        order.reserve(n + 1);
+        order.push_back(root);
+        up[root] = root;
+        for (size_t i = 0; i < order.size(); ++i) {
+            const int x = order[i];
+            for (size_t k = degree[x]; k < degree[x + 1]; ++k) {
+                const int y = other[k];
+                if (y == up[x] && link[k] == upArc[x])
+                    continue;
+                if (up[y] >= 0)
+                    return false; // Cycle
+                up[y] = x;
+                upArc[y] = link[k];
+                order.push_back(y);
+            }
+        }
+        if (order.size() != static_cast<size_t>(n) + 1)
+            return false; // Not spanning
+
+        // Subtree balances, detaching subtrees a real arc cannot carry
+        vector<long long> balance(n + 1, 0);
+        for (size_t i = order.size(); i-- > 1;) {
+            const int x = order[i];
+            balance[x] += supply[x];
+            const size_t a = upArc[x];
+            if (a != NO_ARC) {
+                const bool upward = source[a] == x;
+                if (upward ? balance[x] < 0 : balance[x] >= 0) {
+                    up[x] = root;
+                    upArc[x] = NO_ARC;
+                }
+            }
+            if (up[x] != root)
+                balance[up[x]] += balance[x];
+        }
+
+        // Install the tree
+        fill(flow.begin(), flow.end(), 0);
+        for (int v = 0; v < n; ++v) {
+            source[m + v] = v;
+            target[m + v] = root;
+        }
+        parent[root] = -1;
+        pred[root] = NO_ARC;
+        dir[root] = 0;
+        for (int x = 0; x < n; ++x) {
+            parent[x] = up[x];
+            size_t a = upArc[x];
+            if (a == NO_ARC) {
+                a = m + x;
+                if (balance[x] < 0) {
+                    source[a] = root;
+                    target[a] = x;
+                }
+            }
+            pred[x] = a;
+            dir[x] = source[a] == x ? UP : DOWN;
+            flow[a] = dir[x] == UP ? balance[x] : -balance[x];
+        }
+
+        // Thread in depth-first preorder, children by increasing index
+        vector<size_t> childBegin(n + 2, 0);
+        for (int x = 0; x < n; ++x)
+            ++childBegin[parent[x] + 1];
+        for (int v = 0; v <= n; ++v)
+            childBegin[v + 1] += childBegin[v];
+        vector<int> child(n);
+        {
+            vector<size_t> slot(childBegin.begin(), childBegin.end() - 1);
+            for (int x = 0; x < n; ++x)
+                child[slot[parent[x]]++] = x;
+        }
+        order.clear();
+        vector<int> stack{root};
+        while (!stack.empty()) {
+            const int x = stack.back();
+            stack.pop_back();
+            order.push_back(x);
+            for (size_t k = childBegin[x + 1]; k-- > childBegin[x];)
+                stack.push_back(child[k]);
+        }
+        for (size_t i = 0; i < order.size(); ++i) {
+            const int x = order[i];
+            const int after = order[(i + 1) % order.size()];
+            thread[x] = after;
+            revThread[after] = x;
+            pi[x] = x == root ? 0 : pi[parent[x]] - dir[x] * cost[pred[x]];
+        }
+        for (size_t i = order.size(); i-- > 0;) {
+            const int x = order[i];
+            succNum[x] = 1;
+            for (size_t k = childBegin[x]; k < childBegin[x + 1]; ++k)
+                succNum[x] += succNum[child[k]];
+            lastSucc[x] = order[i + succNum[x] - 1];
+        }
+        return true;
+    }
+
+    /**
+     * @brief Describe the current tree as a basis of the network
+     * @param net Network being solved
+     * @param inst Integral instance of the network
+     * @return Basic edges and root nodes in the network's numbering
+     */
+    SimplexBasis basis(const NetworkFlow &net,
+                       const IntegralInstance &inst) const {
+        vector<size_t> edges;
+        vector<int> roots;
+        for (int x = 0; x < n; ++x) {
+            if (pred[x] < m)
+                edges.push_back(inst.userArc(pred[x]));
+            else
+                roots.push_back(inst.userNode(x));
+        }
+        return SimplexBasis(net, std::move(edges), std::move(roots));
+    }
+
+    /**
+     * @brief Pivot until no arc prices out
+     * @param rule Pricing rule
+     * @param threads Pricing threads, 0 for hardware concurrency
+     * @return False if the problem is unbounded
+     */
+    bool run(PricingRule rule, unsigned threads) {
+        EnteringArc entering({source.data(), target.data(), cost.data(),
+                              pi.data()},
+                             m, rule, threads);
+        for (size_t in = entering.find(); in != NO_ARC;
+             in = entering.find())
+            if (!pivot(in))
+                return false;
+        return true;
+    }
+
+    /**
+     * @brief Check whether all supply reached the demands over real arcs
+     * @return True if no artificial arc carries flow
+     */
+    bool feasible() const {
+        return all_of(flow.begin() + m, flow.end(),
+                      [](long long x) { return x == 0; });
+    }
+};
+
+/**
+ * @brief Every node of an instance
+ * @param inst Integral instance
+ * @return Nodes 0 .. n - 1, the root nodes of a cold start
+ */
+vector<int> allNodes(const IntegralInstance &inst) {
+    vector<int> nodes(inst.graph.numNodes);
+    iota(nodes.begin(), nodes.end(), 0);
+    return nodes;
+}
+
+/**
+ * @brief Start from a stored basis
+ * @param simplex Solver state
+ * @param net Network being solved
+ * @param inst Integral instance of the network
+ * @param basis Stored basis, may be null
+ * @return False if there is no basis or it does not fit the network
+ */
+bool warmStart(NetworkSimplex &simplex, const NetworkFlow &net,
+               const IntegralInstance &inst, const SimplexBasis *basis) {
+    if (!basis || !basis->matches(net))
+        return false;
+    const size_t m = inst.graph.numArcs();
+    vector<size_t> arcOf(m);
+    for (size_t a = 0; a < m; ++a)
+        arcOf[inst.userArc(a)] = a;
+    vector<int> nodeOf(inst.graph.numNodes);
+    for (int v = 0; v < inst.graph.numNodes; ++v)
+        nodeOf[inst.userNode(v)] = v;
+
+    vector<size_t> arcs;
+    vector<int> roots;
+    arcs.reserve(basis->edges().size());
+    roots.reserve(basis->rootNodes().size());
+    for (size_t e : basis->edges())
+        arcs.push_back(arcOf[e]);
+    for (int v : basis->rootNodes())
+        roots.push_back(nodeOf[v]);
+    return simplex.start(inst.supply, arcs, roots);
+}
+
+} // namespace
+
+/**
+ * @brief Construct a solver for a network
+ * @param network Network to solve, must outlive the solver
+ */
+NetworkSimplexSolver::NetworkSimplexSolver(const NetworkFlow &network)
+    : net(network) {}
+
+/**
+ * @brief Solve the network
+ * @param options Solve options (threads, pricing rule, node order,
+ *        starting basis)
+ * @return Solution with flows, optimal potentials and the optimal basis
+ *
+ * Starts from SolveOptions::initialBasis when it fits the network, and
+ * from the all-artificial tree otherwise. Returns status "Infeasible" or
+ * "Unbounded" without flows when the network has no optimal solution, and
+ * explains why if the data cannot be scaled to integers.
+ */
+Solution NetworkSimplexSolver::solve(const SolveOptions &options) const {
+    Solution result;
+    IntegralInstance inst(net, options.threads, options.nodeOrder);
+    if (!nativePrecheck(net, inst, result, options.threads))
+        return result;
+    TraceScope trace("network simplex", "engine");
+
+    // Artificial arcs must cost more than any simple path of real arcs
+    const long long n = inst.graph.numNodes;
+    long long largest = 0;
+    for (long long c : inst.cost)
+        largest = max(largest, std::llabs(c));
+    if (largest > (MAX_ARTIFICIAL_COST - 1) / (n + 1)) {
+        result.status = "Costs are too large for the network simplex";
+        return result;
+    }
+
+    SolveArena arena(arenaBytes(inst) + 24 * inst.graph.numArcs());
+    NetworkSimplex simplex(inst, (n + 1) * largest + 1, arena);
+    if (!warmStart(simplex, net, inst, options.initialBasis.get()))
+        simplex.start(inst.supply, {}, allNodes(inst));
+    if (!simplex.run(options.pricing, options.threads)) {
+        result.status = "Unbounded";
+        return result;
+    }
+    if (!simplex.feasible()) {
+        result.status = "Infeasible";
+        return result;
+    }
+
+    const size_t m = inst.graph.numArcs();
+    vector<long long> flow(simplex.flow.begin(), simplex.flow.begin() + m);
+    vector<long long> potential(simplex.pi.begin(), simplex.pi.begin() + n);
+    result = nativeSolution(net, inst, flow, potential);
+    result.basis = make_shared<const SimplexBasis>(simplex.basis(net, inst));
+    return result;
+}
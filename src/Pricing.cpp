@@ -0,0 +1,315 @@
+/**
+ * @file Pricing.cpp
+ * @brief Implementation of the pricing kernels
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ *
+ * The vector variants are compiled with per-function target attributes, so
+ * the rest of the program needs no special compiler flags and still runs on
+ * CPUs without AVX2.
+ */
+
+#include "Pricing.hpp"
+#include "ShortestPath.hpp"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define PRICING_X86 1
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+/**
+ * @brief Keep the better of two candidates
+ * @param best Current best, updated in place
+ * @param reduced Reduced cost of the challenger
+ * @param arc Arc of the challenger
+ *
+ * Lower reduced cost wins, then lower arc index, so the vector variants,
+ * which visit arcs out of order, agree with the scalar one.
+ */
+inline void consider(ArcPrice &best, long long reduced, size_t arc) {
+    if (reduced < best.reduced ||
+        (reduced == best.reduced && reduced < 0 && arc < best.arc)) {
+        best.reduced = reduced;
+        best.arc = arc;
+    }
+}
+
+inline long long reducedCost(const PricingArcs &p, size_t a) {
+    return p.cost[a] + p.pi[p.source[a]] - p.pi[p.target[a]];
+}
+
+ArcPrice priceRangeScalar(const PricingArcs &p, size_t begin, size_t end) {
+    ArcPrice best{0, NO_ARC};
+    for (size_t a = begin; a < end; ++a)
+        consider(best, reducedCost(p, a), a);
+    return best;
+}
+
+void rangeScalar(const PricingArcs &p, size_t begin, size_t end,
+                 long long *out) {
+    for (size_t a = begin; a < end; ++a)
+        out[a - begin] = reducedCost(p, a);
+}
+
+void listScalar(const PricingArcs &p, const size_t *list, size_t count,
+                long long *out) {
+    for (size_t i = 0; i < count; ++i)
+        out[i] = reducedCost(p, list[i]);
+}
+
+#ifdef PRICING_X86
+
+__attribute__((target("avx2"))) ArcPrice
+priceRangeAvx2(const PricingArcs &p, size_t begin, size_t end) {
+    const long long *pi = p.pi;
+    __m256i bestValue = _mm256_setzero_si256();
+    __m256i bestArc = _mm256_set1_epi64x(-1);
+    __m256i arc = _mm256_setr_epi64x(begin, begin + 1, begin + 2, begin + 3);
+    const __m256i step = _mm256_set1_epi64x(4);
+    size_t a = begin;
+    for (; a + 4 <= end; a += 4) {
+        __m128i s = _mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(p.source + a));
+        __m128i t = _mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(p.target + a));
+        __m256i c =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p.cost + a));
+        __m256i r = _mm256_sub_epi64(
+            _mm256_add_epi64(c, _mm256_i32gather_epi64(pi, s, 8)),
+            _mm256_i32gather_epi64(pi, t, 8));
+        // Strictly better only, so each lane keeps its first minimum
+        __m256i better = _mm256_cmpgt_epi64(bestValue, r);
+        bestValue = _mm256_blendv_epi8(bestValue, r, better);
+        bestArc = _mm256_blendv_epi8(bestArc, arc, better);
+        arc = _mm256_add_epi64(arc, step);
+    }
+
+    alignas(32) long long value[4], index[4];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(value), bestValue);
+    _mm256_store_si256(reinterpret_cast<__m256i *>(index), bestArc);
+    ArcPrice best{0, NO_ARC};
+    for (int j = 0; j < 4; ++j)
+        if (value[j] < 0)
+            consider(best, value[j], static_cast<size_t>(index[j]));
+    for (; a < end; ++a)
+        consider(best, reducedCost(p, a), a);
+    return best;
+}
+
+__attribute__((target("avx2"))) void
+rangeAvx2(const PricingArcs &p, size_t begin, size_t end, long long *out) {
+    const long long *pi = p.pi;
+    size_t a = begin;
+    for (; a + 4 <= end; a += 4) {
+        __m128i s = _mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(p.source + a));
+        __m128i t = _mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(p.target + a));
+        __m256i c =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p.cost + a));
+        __m256i r = _mm256_sub_epi64(
+            _mm256_add_epi64(c, _mm256_i32gather_epi64(pi, s, 8)),
+            _mm256_i32gather_epi64(pi, t, 8));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + (a - begin)),
+                            r);
+    }
+    for (; a < end; ++a)
+        out[a - begin] = reducedCost(p, a);
+}
+
+__attribute__((target("avx2"))) void listAvx2(const PricingArcs &p,
+                                              const size_t *list,
+                                              size_t count, long long *out) {
+    static_assert(sizeof(size_t) == sizeof(long long),
+                  "Arc lists are gathered as 64-bit indices");
+    const long long *pi = p.pi;
+    const long long *cost = p.cost;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i arcs =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(list + i));
+        __m128i s = _mm256_i64gather_epi32(p.source, arcs, 4);
+        __m128i t = _mm256_i64gather_epi32(p.target, arcs, 4);
+        __m256i c = _mm256_i64gather_epi64(cost, arcs, 8);
+        __m256i r = _mm256_sub_epi64(
+            _mm256_add_epi64(c, _mm256_i32gather_epi64(pi, s, 8)),
+            _mm256_i32gather_epi64(pi, t, 8));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), r);
+    }
+    for (; i < count; ++i)
+        out[i] = reducedCost(p, list[i]);
+}
+
+/// Mask selecting all eight lanes of an AVX-512 gather
+constexpr __mmask8 ALL_LANES = 0xFF;
+
+// GCC's unmasked AVX-512 gathers merge into an uninitialized vector, which
+// -Wmaybe-uninitialized reports wherever they are inlined. These use the
+// masked form with every lane selected and a zero source instead, which
+// loads the same values for one extra register clear.
+
+__attribute__((target("avx512f"))) inline __m512i
+gather64(const long long *base, __m256i index) {
+    return _mm512_mask_i32gather_epi64(_mm512_setzero_si512(), ALL_LANES,
+                                       index, base, 8);
+}
+
+__attribute__((target("avx512f"))) inline __m512i
+gather64(const long long *base, __m512i index) {
+    return _mm512_mask_i64gather_epi64(_mm512_setzero_si512(), ALL_LANES,
+                                       index, base, 8);
+}
+
+__attribute__((target("avx512f"))) inline __m256i
+gather32(const int *base, __m512i index) {
+    return _mm512_mask_i64gather_epi32(_mm256_setzero_si256(), ALL_LANES,
+                                       index, base, 4);
+}
+
+__attribute__((target("avx512f"))) ArcPrice
+priceRangeAvx512(const PricingArcs &p, size_t begin, size_t end) {
+    const long long *pi = p.pi;
+    __m512i bestValue = _mm512_setzero_si512();
+    __m512i bestArc = _mm512_set1_epi64(-1);
+    __m512i arc = _mm512_add_epi64(_mm512_set1_epi64(begin),
+                                   _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7));
+    const __m512i step = _mm512_set1_epi64(8);
+    size_t a = begin;
+    for (; a + 8 <= end; a += 8) {
+        __m256i s = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(p.source + a));
+        __m256i t = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(p.target + a));
+        __m512i c = _mm512_loadu_si512(p.cost + a);
+        __m512i r = _mm512_sub_epi64(
+            _mm512_add_epi64(c, gather64(pi, s)), gather64(pi, t));
+        __mmask8 better = _mm512_cmplt_epi64_mask(r, bestValue);
+        bestValue = _mm512_mask_mov_epi64(bestValue, better, r);
+        bestArc = _mm512_mask_mov_epi64(bestArc, better, arc);
+        arc = _mm512_add_epi64(arc, step);
+    }
+
+    alignas(64) long long value[8], index[8];
+    _mm512_store_si512(value, bestValue);
+    _mm512_store_si512(index, bestArc);
+    ArcPrice best{0, NO_ARC};
+    for (int j = 0; j < 8; ++j)
+        if (value[j] < 0)
+            consider(best, value[j], static_cast<size_t>(index[j]));
+    for (; a < end; ++a)
+        consider(best, reducedCost(p, a), a);
+    return best;
+}
+
+__attribute__((target("avx512f"))) void
+rangeAvx512(const PricingArcs &p, size_t begin, size_t end, long long *out) {
+    const long long *pi = p.pi;
+    size_t a = begin;
+    for (; a + 8 <= end; a += 8) {
+        __m256i s = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(p.source + a));
+        __m256i t = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(p.target + a));
+        __m512i c = _mm512_loadu_si512(p.cost + a);
+        __m512i r = _mm512_sub_epi64(
+            _mm512_add_epi64(c, gather64(pi, s)), gather64(pi, t));
+        _mm512_storeu_si512(out + (a - begin), r);
+    }
+    for (; a < end; ++a)
+        out[a - begin] = reducedCost(p, a);
+}
+
+__attribute__((target("avx512f"))) void listAvx512(const PricingArcs &p,
+                                                   const size_t *list,
+                                                   size_t count,
+                                                   long long *out) {
+    const long long *pi = p.pi;
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m512i arcs = _mm512_loadu_si512(list + i);
+        __m256i s = gather32(p.source, arcs);
+        __m256i t = gather32(p.target, arcs);
+        __m512i c = gather64(p.cost, arcs);
+        __m512i r = _mm512_sub_epi64(
+            _mm512_add_epi64(c, gather64(pi, s)), gather64(pi, t));
+        _mm512_storeu_si512(out + i, r);
+    }
+    for (; i < count; ++i)
+        out[i] = reducedCost(p, list[i]);
+}
+
+#endif
+
+/**
+ * @struct Kernels
+ * @brief Kernel variants selected for this CPU
+ */
+struct Kernels {
+    ArcPrice (*price)(const PricingArcs &, size_t, size_t);
+    void (*range)(const PricingArcs &, size_t, size_t, long long *);
+    void (*list)(const PricingArcs &, const size_t *, size_t, long long *);
+    const char *name;
+};
+
+Kernels selectKernels() {
+#ifdef PRICING_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return {priceRangeAvx512, rangeAvx512, listAvx512, "avx512f"};
+    if (__builtin_cpu_supports("avx2"))
+        return {priceRangeAvx2, rangeAvx2, listAvx2, "avx2"};
+#endif
+    return {priceRangeScalar, rangeScalar, listScalar, "scalar"};
+}
+
+const Kernels &kernels() {
+    static const Kernels selected = selectKernels();
+    return selected;
+}
+
+} // namespace
+
+/**
+ * @brief Find the arc with the most negative reduced cost in a range
+ * @param arcs Arcs and potentials
+ * @param begin First arc
+ * @param end One past the last arc
+ * @return Most negative reduced cost and its arc, or {0, NO_ARC}
+ */
+ArcPrice priceRange(const PricingArcs &arcs, size_t begin, size_t end) {
+    return kernels().price(arcs, begin, end);
+}
+
+/**
+ * @brief Reduced costs of a range of arcs
+ * @param arcs Arcs and potentials
+ * @param begin First arc
+ * @param end One past the last arc
+ * @param out Receives end - begin reduced costs
+ */
+void rangeReducedCosts(const PricingArcs &arcs, size_t begin, size_t end,
+                       long long *out) {
+    kernels().range(arcs, begin, end, out);
+}
+
+/**
+ * @brief Reduced costs of listed arcs
+ * @param arcs Arcs and potentials
+ * @param list Arc indices
+ * @param count Number of listed arcs
+ * @param out Receives count reduced costs
+ */
+void listReducedCosts(const PricingArcs &arcs, const size_t *list,
+                      size_t count, long long *out) {
+    kernels().list(arcs, list, count, out);
+}
+
+/**
+ * @brief Instruction set the kernels run with on this CPU
+ * @return "avx512f", "avx2" or "scalar"
+ */
+const char *pricingInstructionSet() { return kernels().name; }
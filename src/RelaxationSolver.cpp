@@ -0,0 +1,466 @@
+/**
+ * @file RelaxationSolver.cpp
+ * @brief Implementation of the RELAX-IV style dual ascent solver
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ *
+ * Notation: arc a = (u, v) has scaled cost c[a], flow x[a] in [0, U] and
+ * reduced cost r[a] = c[a] + pi[u] - pi[v]. Complementary slackness (CS)
+ * requires x[a] = 0 if r[a] > 0 and x[a] = U if r[a] < 0. The surplus of a
+ * node is its supply plus inflow minus outflow. Raising the price of a node
+ * set S means lowering pi on S.
+ *
+ * Edges are uncapacitated. Without negative cycles some optimal flow sends
+ * at most the total supply through any arc, so U = total supply is used as
+ * the capacity required by the relaxation method.
+ */
+
+#include "RelaxationSolver.hpp"
+#include "Counters.hpp"
+#include "NativeSolver.hpp"
+#include "Trace.hpp"
+#include <limits>
+
+using namespace std;
+
+namespace {
+
+/// Sweeps of the auction initialization over the surplus nodes
+constexpr int AUCTION_PASSES = 3;
+
+constexpr long long INF = numeric_limits<long long>::max();
+
+/**
+ * @class Relaxation
+ * @brief State of one relaxation solve
+ */
+class Relaxation {
+private:
+    const FlowGraph &g;
+    const vector<long long> &c;
+    const long long U;
+
+    SolveArena &arena;
+    ArenaVector<long long> surplus;
+    NodeQueue active;
+
+    // Node set S of the current iteration, identified by stamp
+    ArenaVector<unsigned> inSet;
+    unsigned stamp;
+    ArenaVector<int> members;
+    ArenaVector<size_t> predArc;
+    ArenaVector<char> predForward;
+    ArenaVector<size_t> pending;
+    ArenaVector<size_t> limiting;
+    long long slope;
+
+public:
+    vector<long long> x;
+    vector<long long> pi;
+
+    Relaxation(const IntegralInstance &inst, vector<long long> potentials,
+               SolveArena &memory)
+        : g(inst.graph), c(inst.cost), U(inst.totalSupply), arena(memory),
+          surplus(inst.supply.begin(), inst.supply.end(), memory.get()),
+          active(inst.graph.numNodes, memory),
+          inSet(memory.vector<unsigned>(inst.graph.numNodes, 0)), stamp(0),
+          members(memory.get()),
+          predArc(memory.vector<size_t>(inst.graph.numNodes)),
+          predForward(memory.vector<char>(inst.graph.numNodes)),
+          pending(memory.get()), limiting(memory.get()), slope(0),
+          x(inst.graph.numArcs(), 0), pi(std::move(potentials)) {}
+
+    long long reduced(size_t a) const {
+        return c[a] + pi[g.source[a]] - pi[g.target[a]];
+    }
+
+    bool loop(size_t a) const { return g.source[a] == g.target[a]; }
+
+    void gain(int v, long long d) {
+        surplus[v] += d;
+        if (surplus[v] > 0)
+            active.push(v);
+    }
+
+    /**
+     * @brief Set flows to satisfy CS with the current potentials
+     */
+    void initFlows() {
+        for (size_t a = 0; a < x.size(); ++a) {
+            if (loop(a) || reduced(a) >= 0)
+                continue;
+            x[a] = U;
+            surplus[g.source[a]] -= U;
+            surplus[g.target[a]] += U;
+        }
+    }
+
+    /**
+     * @brief Auction-style initialization
+     *
+     * Each node with surplus bids for its cheapest residual arc: its price
+     * rises until that arc is balanced, and the surplus is pushed along all
+     * balanced residual arcs. Receiving nodes bid in turn during the same
+     * sweep. Every step keeps CS, so the result is a valid starting point
+     * for the relaxation iterations.
+     */
+    void auction() {
+        for (int pass = 0; pass < AUCTION_PASSES; ++pass) {
+            bool progress = false;
+            for (int v = 0; v < g.numNodes; ++v) {
+                if (surplus[v] <= 0)
+                    continue;
+
+                long long best = INF;
+                for (size_t i = g.outBegin[v]; i < g.outBegin[v + 1]; ++i) {
+                    size_t a = g.outArcs[i];
+                    if (!loop(a) && x[a] < U)
+                        best = min(best, reduced(a));
+                }
+                for (size_t i = g.inBegin[v]; i < g.inBegin[v + 1]; ++i) {
+                    size_t a = g.inArcs[i];
+                    if (!loop(a) && x[a] > 0)
+                        best = min(best, -reduced(a));
+                }
+                if (best == INF)
+                    continue;
+
+                pi[v] -= best;
+                progress = true;
+                EventCounters::add(Counter::Relabels);
+                for (size_t i = g.outBegin[v];
+                     i < g.outBegin[v + 1] && surplus[v] > 0; ++i) {
+                    size_t a = g.outArcs[i];
+                    if (loop(a) || x[a] == U || reduced(a) != 0)
+                        continue;
+                    long long d = min(surplus[v], U - x[a]);
+                    x[a] += d;
+                    surplus[v] -= d;
+                    surplus[g.target[a]] += d;
+                    EventCounters::add(Counter::Pushes);
+                }
+                for (size_t i = g.inBegin[v];
+                     i < g.inBegin[v + 1] && surplus[v] > 0; ++i) {
+                    size_t a = g.inArcs[i];
+                    if (loop(a) || x[a] == 0 || reduced(a) != 0)
+                        continue;
+                    long long d = min(surplus[v], x[a]);
+                    x[a] -= d;
+                    surplus[v] -= d;
+                    surplus[g.source[a]] += d;
+                    EventCounters::add(Counter::Pushes);
+                }
+            }
+            if (!progress)
+                break;
+        }
+    }
+
+    /**
+     * @brief Add a node to S and update the dual directional derivative
+     *
+     * The slope of the dual along a price rise of S is the surplus of S
+     * minus the flow that balanced boundary arcs would have to move out of
+     * S. Arcs between the new node and S stop being boundary arcs.
+     */
+    void addToSet(int k) {
+        inSet[k] = stamp;
+        members.push_back(k);
+        slope += surplus[k];
+        for (size_t i = g.outBegin[k]; i < g.outBegin[k + 1]; ++i) {
+            size_t a = g.outArcs[i];
+            if (loop(a) || reduced(a) != 0)
+                continue;
+            if (inSet[g.target[a]] == stamp)
+                slope += x[a];
+            else
+                slope -= U - x[a];
+        }
+        for (size_t i = g.inBegin[k]; i < g.inBegin[k + 1]; ++i) {
+            size_t a = g.inArcs[i];
+            if (loop(a) || reduced(a) != 0)
+                continue;
+            if (inSet[g.source[a]] == stamp)
+                slope += U - x[a];
+            else
+                slope -= x[a];
+        }
+    }
+
+    /**
+     * @brief Raise the prices of S by the largest step keeping CS
+     * @return False if the step is unbounded, i.e. the problem is infeasible
+     *
+     * Balanced boundary arcs are first moved to the bound CS will require
+     * after the rise. The boundary arcs that limit the step become balanced
+     * and are queued in pending, and the slope is recomputed for them.
+     */
+    bool raisePrices() {
+        long long gamma = INF;
+        long long setSurplus = 0;
+        limiting.clear();
+        for (int v : members) {
+            for (size_t i = g.outBegin[v]; i < g.outBegin[v + 1]; ++i) {
+                size_t a = g.outArcs[i];
+                int w = g.target[a];
+                if (inSet[w] == stamp)
+                    continue;
+                long long r = reduced(a);
+                if (r == 0 && x[a] < U) {
+                    long long d = U - x[a];
+                    x[a] = U;
+                    surplus[v] -= d;
+                    gain(w, d);
+                    EventCounters::add(Counter::Pushes);
+                } else if (r > 0 && r <= gamma) {
+                    if (r < gamma)
+                        limiting.clear();
+                    gamma = r;
+                    limiting.push_back(a);
+                }
+            }
+            for (size_t i = g.inBegin[v]; i < g.inBegin[v + 1]; ++i) {
+                size_t a = g.inArcs[i];
+                int w = g.source[a];
+                if (inSet[w] == stamp)
+                    continue;
+                long long r = reduced(a);
+                if (r == 0 && x[a] > 0) {
+                    long long d = x[a];
+                    x[a] = 0;
+                    surplus[v] -= d;
+                    gain(w, d);
+                    EventCounters::add(Counter::Pushes);
+                } else if (r < 0 && -r <= gamma) {
+                    if (-r < gamma)
+                        limiting.clear();
+                    gamma = -r;
+                    limiting.push_back(a);
+                }
+            }
+            setSurplus += surplus[v];
+        }
+        if (gamma == INF)
+            return false;
+        for (int v : members)
+            pi[v] -= gamma;
+        EventCounters::add(Counter::Relabels, members.size());
+
+        // Limiting arcs are now balanced; x is 0 on outgoing and U on
+        // incoming ones, so each subtracts U from the slope
+        slope = setSurplus;
+        for (size_t a : limiting) {
+            slope -= U;
+            pending.push_back(a);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Augment flow from s to the deficit node t along labeled arcs
+     */
+    void augment(int s, int t) {
+        long long delta = min(surplus[s], -surplus[t]);
+        for (int v = t; v != s;) {
+            size_t a = predArc[v];
+            if (predForward[v]) {
+                delta = min(delta, U - x[a]);
+                v = g.source[a];
+            } else {
+                delta = min(delta, x[a]);
+                v = g.target[a];
+            }
+        }
+        for (int v = t; v != s;) {
+            size_t a = predArc[v];
+            if (predForward[v]) {
+                x[a] += delta;
+                v = g.source[a];
+            } else {
+                x[a] -= delta;
+                v = g.target[a];
+            }
+        }
+        surplus[s] -= delta;
+        surplus[t] += delta;
+        EventCounters::add(Counter::Augmentations);
+    }
+
+    /**
+     * @brief Label w through the balanced residual arc a
+     * @return True if w is a deficit node and flow was augmented
+     */
+    bool label(int s, int w, size_t a, bool forward) {
+        predArc[w] = a;
+        predForward[w] = forward;
+        if (surplus[w] < 0) {
+            augment(s, w);
+            return true;
+        }
+        addToSet(w);
+        return false;
+    }
+
+    /**
+     * @brief One relaxation iteration started at a surplus node
+     * @return False if the problem was found to be infeasible
+     *
+     * S grows along balanced residual arcs. Whenever the dual slope of S
+     * turns positive its prices are raised, and growth continues from the
+     * arcs that became balanced; the labeled paths inside S stay valid
+     * because flows and reduced costs of internal arcs do not change. The
+     * iteration ends with an augmentation when a deficit node is labeled,
+     * or when s has lost its surplus to the price rises.
+     */
+    bool iterate(int s) {
+        ++stamp;
+        members.clear();
+        pending.clear();
+        slope = 0;
+        addToSet(s);
+
+        size_t next = 0;
+        while (surplus[s] > 0) {
+            if (slope > 0 || (pending.empty() && next == members.size())) {
+                // With nothing left to label, the slope equals the positive
+                // surplus of S, so a price rise is always possible here
+                if (!raisePrices())
+                    return false;
+                continue;
+            }
+
+            if (!pending.empty()) {
+                size_t a = pending.back();
+                pending.pop_back();
+                bool forward = inSet[g.source[a]] == stamp;
+                int w = forward ? g.target[a] : g.source[a];
+                if (inSet[w] != stamp && label(s, w, a, forward))
+                    return true;
+                continue;
+            }
+
+            int v = members[next];
+            bool grown = false;
+            for (size_t i = g.outBegin[v]; i < g.outBegin[v + 1] && !grown;
+                 ++i) {
+                size_t a = g.outArcs[i];
+                int w = g.target[a];
+                if (inSet[w] == stamp || x[a] == U || reduced(a) != 0)
+                    continue;
+                if (label(s, w, a, true))
+                    return true;
+                grown = slope > 0;
+            }
+            for (size_t i = g.inBegin[v]; i < g.inBegin[v + 1] && !grown;
+                 ++i) {
+                size_t a = g.inArcs[i];
+                int w = g.source[a];
+                if (inSet[w] == stamp || x[a] == 0 || reduced(a) != 0)
+                    continue;
+                if (label(s, w, a, false))
+                    return true;
+                grown = slope > 0;
+            }
+            // A node interrupted by a positive slope is scanned again later
+            if (!grown)
+                ++next;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Run the relaxation iterations until all surpluses vanish
+     * @return False if the problem is infeasible
+     */
+    bool run() {
+        for (int v = 0; v < g.numNodes; ++v)
+            if (surplus[v] > 0)
+                active.push(v);
+        while (!active.empty()) {
+            int s = active.pop();
+            while (surplus[s] > 0) {
+                if (!iterate(s))
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Make the potentials a certificate for the uncapacitated problem
+     *
+     * An arc saturated at the artificial capacity U may keep a negative
+     * reduced cost. In that case the potentials are recomputed as shortest
+     * path distances in the residual graph of the optimal flow, which has
+     * no negative cycle.
+     */
+    void repairPotentials() {
+        bool valid = true;
+        for (size_t a = 0; a < x.size() && valid; ++a)
+            valid = loop(a) || reduced(a) >= 0;
+        if (valid)
+            return;
+
+        const int n = g.numNodes;
+        fill(pi.begin(), pi.end(), 0);
+        NodeQueue queue(n, arena);
+        for (int v = 0; v < n; ++v)
+            queue.push(v);
+
+        while (!queue.empty()) {
+            int u = queue.pop();
+            auto relax = [&](int v, long long d) {
+                if (d < pi[v]) {
+                    pi[v] = d;
+                    queue.push(v);
+                }
+            };
+            for (size_t i = g.outBegin[u]; i < g.outBegin[u + 1]; ++i) {
+                size_t a = g.outArcs[i];
+                relax(g.target[a], pi[u] + c[a]);
+            }
+            for (size_t i = g.inBegin[u]; i < g.inBegin[u + 1]; ++i) {
+                size_t a = g.inArcs[i];
+                if (x[a] > 0)
+                    relax(g.source[a], pi[u] - c[a]);
+            }
+        }
+    }
+};
+
+} // namespace
+
+/**
+ * @brief Construct a solver for a network
+ * @param network Network to solve, must outlive the solver
+ */
+RelaxationSolver::RelaxationSolver(const NetworkFlow &network)
+    : net(network) {}
+
+/**
+ * @brief Solve the network
+ * @param options Solve options (threads, warm-start potentials)
+ * @return Solution with flows and optimal potentials
+ *
+ * Returns status "Infeasible" or "Unbounded" without flows when the network
+ * has no optimal solution, and explains why if the data cannot be scaled to
+ * integers.
+ */
+Solution RelaxationSolver::solve(const SolveOptions &options) const {
+    Solution result;
+    IntegralInstance inst(net, options.threads, options.nodeOrder);
+    if (!nativePrecheck(net, inst, result, options.threads))
+        return result;
+    TraceScope trace("relaxation", "engine");
+
+    SolveArena arena(arenaBytes(inst));
+    Relaxation relax(inst, scaledPotentials(options, inst), arena);
+    relax.initFlows();
+    relax.auction();
+    if (!relax.run()) {
+        result.status = "Infeasible";
+        return result;
+    }
+    relax.repairPotentials();
+    return nativeSolution(net, inst, relax.x, relax.pi);
+}
@@ -0,0 +1,765 @@
+/**
+ * @file ShortestPath.cpp
+ * @brief Implementation of the parallel shortest path kernels
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ */
+
+#include "ShortestPath.hpp"
+#include "Counters.hpp"
+#include "Metrics.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <deque>
+#include <map>
+#include <memory>
+#include <queue>
+
+using namespace std;
+
+namespace {
+
+/// Nodes per thread below which a round runs on the calling thread
+constexpr size_t MIN_PARALLEL_NODES = 1024;
+
+/**
+ * @brief Check whether a tentative distance improves a label
+ * @param d Tentative distance
+ * @param current Current label
+ * @return True if d is smaller
+ *
+ * Floating point labels must drop by a relative margin so that rounding
+ * noise on zero-cost cycles cannot keep a search alive.
+ */
+bool improves(double d, double current) {
+    if (!std::isfinite(current))
+        return d < current;
+    return d < current - 1e-9 * max(1.0, std::abs(current));
+}
+
+bool improves(long long d, long long current) { return d < current; }
+
+/**
+ * @brief Append per-worker lists into one vector
+ * @param parts Lists to join, cleared afterwards
+ * @param out Receives the concatenation
+ */
+template <typename T>
+void gather(vector<vector<T>> &parts, vector<T> &out) {
+    out.clear();
+    for (vector<T> &part : parts) {
+        out.insert(out.end(), part.begin(), part.end());
+        part.clear();
+    }
+}
+
+/**
+ * @brief Find a cycle in a predecessor graph
+ * @param g Graph the predecessors refer to
+ * @param pred Predecessor arc per node
+ * @return Arcs of a cycle in traversal order, or an empty vector
+ *
+ * A chain that revisits its own start mark closes a cycle.
+ */
+vector<size_t> predecessorCycle(const FlowGraph &g,
+                                const vector<size_t> &pred) {
+    const size_t n = static_cast<size_t>(g.numNodes);
+    vector<size_t> mark(n, 0);
+    for (size_t s = 0; s < n; ++s) {
+        size_t v = s;
+        while (mark[v] == 0 && pred[v] != NO_ARC) {
+            mark[v] = s + 1;
+            v = static_cast<size_t>(g.source[pred[v]]);
+        }
+        if (mark[v] != s + 1)
+            continue;
+
+        vector<size_t> cycle;
+        size_t u = v;
+        do {
+            cycle.push_back(pred[u]);
+            u = static_cast<size_t>(g.source[pred[u]]);
+        } while (u != v);
+        reverse(cycle.begin(), cycle.end());
+        return cycle;
+    }
+    return {};
+}
+
+/**
+ * @brief Find a cycle among the predecessors inside one component
+ * @param g Graph the predecessors refer to
+ * @param cond Components of g
+ * @param c Component to check
+ * @param pred Predecessor arc per node
+ * @param mark Per-node scratch holding no value above stamp
+ * @param stamp Last mark used, advanced by the call
+ * @return Arcs of a cycle in traversal order, or an empty vector
+ *
+ * Like predecessorCycle(), but chains stop at arcs from earlier
+ * components, which lie on no cycle, so a check costs the size of the
+ * component rather than of the graph.
+ */
+vector<size_t> componentCycle(const FlowGraph &g, const Condensation &cond,
+                              int c, const vector<size_t> &pred,
+                              vector<size_t> &mark, size_t &stamp) {
+    const size_t base = stamp;
+    for (size_t i = cond.begin[c]; i < cond.begin[c + 1]; ++i) {
+        const size_t s = ++stamp;
+        int v = cond.nodes[i];
+        while (mark[v] <= base && pred[v] != NO_ARC &&
+               cond.component[g.source[pred[v]]] == c) {
+            mark[v] = s;
+            v = g.source[pred[v]];
+        }
+        if (mark[v] != s)
+            continue;
+
+        vector<size_t> cycle;
+        int u = v;
+        do {
+            cycle.push_back(pred[u]);
+            u = g.source[pred[u]];
+        } while (u != v);
+        reverse(cycle.begin(), cycle.end());
+        return cycle;
+    }
+    return {};
+}
+
+/**
+ * @brief Bucket width for delta-stepping
+ * @param g Graph topology
+ * @param cost Arc costs
+ * @return Largest cost divided by the average out-degree, at least 1
+ */
+template <typename Cost>
+Cost defaultDelta(const FlowGraph &g, const vector<Cost> &cost) {
+    Cost largest = 0;
+    for (Cost c : cost)
+        largest = max(largest, c);
+    double degree = max(1.0, static_cast<double>(g.numArcs()) /
+                                 max(1, g.numNodes));
+    Cost delta = static_cast<Cost>(largest / degree);
+    return delta > 0 ? delta : Cost(1);
+}
+
+} // namespace
+
+/**
+ * @brief Parallel delta-stepping for nonnegative costs
+ * @param g Graph topology
+ * @param cost Nonnegative cost per arc
+ * @param sources Start nodes, all at distance zero
+ * @param threads Worker threads, 0 for hardware concurrency
+ * @param delta Bucket width, 0 to derive it from the costs
+ * @return Distances and shortest path tree
+ */
+template <typename Cost>
+ShortestPathTree<Cost> deltaStepping(const FlowGraph &g,
+                                     const vector<Cost> &cost,
+                                     const vector<int> &sources,
+                                     unsigned threads, Cost delta) {
+    struct Request {
+        int node;
+        Cost dist;
+        size_t arc;
+    };
+
+    const size_t n = static_cast<size_t>(g.numNodes);
+    const unsigned workers = workerCount(threads);
+    if (!(delta > 0))
+        delta = defaultDelta(g, cost);
+
+    ShortestPathTree<Cost> tree;
+    vector<Cost> &dist = tree.dist;
+    dist.assign(n, unreachableDistance<Cost>());
+    tree.pred.assign(n, NO_ARC);
+
+    auto bucketOf = [&](Cost d) {
+        return static_cast<size_t>(min(static_cast<double>(d / delta), 1e18));
+    };
+
+    map<size_t, vector<int>> buckets;
+    for (int s : sources) {
+        dist[s] = 0;
+        buckets[0].push_back(s);
+    }
+
+    vector<vector<Request>> requests(workers);
+    vector<vector<int>> changed(workers);
+    vector<int> improved;
+
+    // Relax the light (cost <= delta) or heavy arcs leaving nodes
+    auto relax = [&](const vector<int> &nodes, bool light) {
+        parallelChunks(
+            nodes.size(), MIN_PARALLEL_NODES, threads,
+            [&](size_t chunk, size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    int u = nodes[i];
+                    for (size_t k = g.outBegin[u]; k < g.outBegin[u + 1];
+                         ++k) {
+                        size_t a = g.outArcs[k];
+                        if ((cost[a] <= delta) != light)
+                            continue;
+                        Cost d = dist[u] + cost[a];
+                        if (d < dist[g.target[a]])
+                            requests[chunk].push_back({g.target[a], d, a});
+                    }
+                }
+            });
+
+        // Each owner applies the requests for its own node range
+        size_t total = 0;
+        for (const auto &r : requests)
+            total += r.size();
+        size_t owners = min<size_t>(
+            workers, max<size_t>(1, total / MIN_PARALLEL_NODES));
+        parallelTasks(owners, threads, [&](size_t t) {
+            int lo = static_cast<int>(n * t / owners);
+            int hi = static_cast<int>(n * (t + 1) / owners);
+            for (const auto &list : requests) {
+                for (const Request &r : list) {
+                    if (r.node < lo || r.node >= hi ||
+                        !(r.dist < dist[r.node]))
+                        continue;
+                    dist[r.node] = r.dist;
+                    tree.pred[r.node] = r.arc;
+                    changed[t].push_back(r.node);
+                }
+            }
+        });
+        for (auto &r : requests)
+            r.clear();
+        gather(changed, improved);
+    };
+
+    vector<unsigned> roundMark(n, 0), bucketMark(n, 0);
+    unsigned round = 0, phase = 0;
+    vector<int> frontier, settled;
+
+    // Keep the nodes of the current bucket for the next light round and
+    // file the others under their bucket
+    auto route = [&](const vector<int> &nodes, size_t index) {
+        ++round;
+        frontier.clear();
+        for (int v : nodes) {
+            size_t b = bucketOf(dist[v]);
+            if (b != index)
+                buckets[b].push_back(v);
+            else if (roundMark[v] != round) {
+                roundMark[v] = round;
+                frontier.push_back(v);
+            }
+        }
+    };
+
+    while (!buckets.empty()) {
+        auto first = buckets.begin();
+        size_t index = first->first;
+        vector<int> pending = std::move(first->second);
+        buckets.erase(first);
+
+        // Entries whose label moved to another bucket are stale
+        pending.erase(remove_if(pending.begin(), pending.end(),
+                                [&](int v) {
+                                    return bucketOf(dist[v]) != index;
+                                }),
+                      pending.end());
+        route(pending, index);
+
+        ++phase;
+        settled.clear();
+        while (!frontier.empty()) {
+            for (int v : frontier) {
+                if (bucketMark[v] != phase) {
+                    bucketMark[v] = phase;
+                    settled.push_back(v);
+                }
+            }
+            relax(frontier, true);
+            route(improved, index);
+        }
+
+        relax(settled, false);
+        for (int v : improved)
+            buckets[bucketOf(dist[v])].push_back(v);
+    }
+    return tree;
+}
+
+/**
+ * @brief Parallel frontier-based Bellman-Ford for arbitrary costs
+ * @param g Graph topology
+ * @param cost Cost per arc
+ * @param initial Starting label per node, unreachableDistance() for none
+ * @param threads Worker threads, 0 for hardware concurrency
+ * @return Distances and shortest path tree, or a negative cycle
+ */
+template <typename Cost>
+ShortestPathTree<Cost> bellmanFord(const FlowGraph &g,
+                                   const vector<Cost> &cost,
+                                   vector<Cost> initial, unsigned threads) {
+    const size_t n = static_cast<size_t>(g.numNodes);
+    const Cost INF = unreachableDistance<Cost>();
+    const unsigned workers = workerCount(threads);
+
+    ShortestPathTree<Cost> tree;
+    vector<Cost> &dist = tree.dist;
+    dist = std::move(initial);
+    tree.pred.assign(n, NO_ARC);
+
+    vector<Cost> next(n);
+    vector<char> inFrontier(n, 0);
+    unique_ptr<atomic<unsigned char>[]> candidate(
+        new atomic<unsigned char>[n]);
+    for (size_t v = 0; v < n; ++v)
+        candidate[v].store(0, memory_order_relaxed);
+
+    vector<int> frontier, candidates;
+    for (size_t v = 0; v < n; ++v) {
+        if (dist[v] != INF) {
+            frontier.push_back(static_cast<int>(v));
+            inFrontier[v] = 1;
+        }
+    }
+
+    vector<vector<int>> local(workers);
+    size_t changes = 0;
+    while (!frontier.empty()) {
+        // Nodes with an arc from the frontier
+        parallelChunks(frontier.size(), MIN_PARALLEL_NODES, threads,
+                       [&](size_t chunk, size_t begin, size_t end) {
+                           for (size_t i = begin; i < end; ++i) {
+                               int u = frontier[i];
+                               for (size_t k = g.outBegin[u];
+                                    k < g.outBegin[u + 1]; ++k) {
+                                   int v = g.target[g.outArcs[k]];
+                                   if (!candidate[v].exchange(
+                                           1, memory_order_relaxed))
+                                       local[chunk].push_back(v);
+                               }
+                           }
+                       });
+        gather(local, candidates);
+
+        // Each candidate pulls its best label over arcs from the frontier.
+        // A serial round may publish labels at once, which lets later
+        // candidates of the same round build on them.
+        const bool serial = workers == 1 ||
+                            candidates.size() < 2 * MIN_PARALLEL_NODES;
+        parallelChunks(candidates.size(), MIN_PARALLEL_NODES, threads,
+                       [&](size_t chunk, size_t begin, size_t end) {
+                           for (size_t i = begin; i < end; ++i) {
+                               int v = candidates[i];
+                               candidate[v].store(0, memory_order_relaxed);
+                               Cost best = dist[v];
+                               size_t arc = NO_ARC;
+                               for (size_t k = g.inBegin[v];
+                                    k < g.inBegin[v + 1]; ++k) {
+                                   size_t a = g.inArcs[k];
+                                   int u = g.source[a];
+                                   if (!inFrontier[u])
+                                       continue;
+                                   Cost d = dist[u] + cost[a];
+                                   if (improves(d, best)) {
+                                       best = d;
+                                       arc = a;
+                                   }
+                               }
+                               if (arc != NO_ARC) {
+                                   next[v] = best;
+                                   if (serial)
+                                       dist[v] = best;
+                                   tree.pred[v] = arc;
+                                   local[chunk].push_back(v);
+                               }
+                           }
+                       });
+
+        for (int v : frontier)
+            inFrontier[v] = 0;
+        gather(local, frontier);
+        for (int v : frontier) {
+            dist[v] = next[v];
+            inFrontier[v] = 1;
+        }
+
+        changes += frontier.size();
+        if (changes >= n) {
+            changes = 0;
+            tree.negativeCycle = predecessorCycle(g, tree.pred);
+            if (!tree.negativeCycle.empty())
+                return tree;
+        }
+    }
+    return tree;
+}
+
+/**
+ * @brief Bellman-Ford that follows the condensation of the graph
+ * @param g Graph topology
+ * @param cond Strongly connected components of g
+ * @param cost Cost per arc
+ * @param initial Starting label per node, unreachableDistance() for none
+ * @param threads Worker threads, 0 for hardware concurrency
+ * @return Same result as bellmanFord()
+ */
+template <typename Cost>
+ShortestPathTree<Cost> condensedBellmanFord(const FlowGraph &g,
+                                            const Condensation &cond,
+                                            const vector<Cost> &cost,
+                                            vector<Cost> initial,
+                                            unsigned threads) {
+    if (workerCount(threads) > 1 && cond.largest() > SERIAL_COMPONENT_NODES)
+        return bellmanFord(g, cost, std::move(initial), threads);
+
+    const size_t n = static_cast<size_t>(g.numNodes);
+    const Cost INF = unreachableDistance<Cost>();
+
+    ShortestPathTree<Cost> tree;
+    vector<Cost> &dist = tree.dist;
+    dist = std::move(initial);
+    tree.pred.assign(n, NO_ARC);
+
+    deque<int> queue;
+    vector<char> queued(n, 0);
+    vector<size_t> mark(n, 0);
+    size_t stamp = 0;
+
+    for (int c = 0; c < cond.numComponents; ++c) {
+        // Labels of earlier components are final
+        bool inner = false;
+        for (size_t i = cond.begin[c]; i < cond.begin[c + 1]; ++i) {
+            int v = cond.nodes[i];
+            for (size_t k = g.inBegin[v]; k < g.inBegin[v + 1]; ++k) {
+                size_t a = g.inArcs[k];
+                int u = g.source[a];
+                if (cond.component[u] == c) {
+                    inner = true;
+                    continue;
+                }
+                if (dist[u] == INF)
+                    continue;
+                Cost d = dist[u] + cost[a];
+                if (improves(d, dist[v])) {
+                    dist[v] = d;
+                    tree.pred[v] = a;
+                }
+            }
+        }
+        if (!inner)
+            continue;
+
+        for (size_t i = cond.begin[c]; i < cond.begin[c + 1]; ++i) {
+            int v = cond.nodes[i];
+            if (dist[v] != INF) {
+                queue.push_back(v);
+                queued[v] = 1;
+            }
+        }
+        size_t changes = 0;
+        while (!queue.empty()) {
+            int u = queue.front();
+            queue.pop_front();
+            queued[u] = 0;
+            for (size_t k = g.outBegin[u]; k < g.outBegin[u + 1]; ++k) {
+                size_t a = g.outArcs[k];
+                int w = g.target[a];
+                if (cond.component[w] != c)
+                    continue;
+                Cost d = dist[u] + cost[a];
+                if (!improves(d, dist[w]))
+                    continue;
+                dist[w] = d;
+                tree.pred[w] = a;
+                if (!queued[w]) {
+                    queued[w] = 1;
+                    queue.push_back(w);
+                }
+                if (++changes < cond.size(c))
+                    continue;
+                changes = 0;
+                tree.negativeCycle =
+                    componentCycle(g, cond, c, tree.pred, mark, stamp);
+                if (!tree.negativeCycle.empty())
+                    return tree;
+            }
+        }
+    }
+    return tree;
+}
+
+/**
+ * @brief Shortest paths from a batch of sources at once
+ * @param g Graph topology
+ * @param cost Nonnegative cost per arc
+ * @param sources Up to MULTI_SOURCE_WIDTH start nodes
+ * @param dist Receives MULTI_SOURCE_WIDTH interleaved labels per node
+ * @param pred Receives the tree arcs in the same layout
+ */
+void multiSourceDistances(const FlowGraph &g, const vector<long long> &cost,
+                          const vector<int> &sources, vector<long long> &dist,
+                          vector<size_t> &pred) {
+    constexpr size_t K = MULTI_SOURCE_WIDTH;
+    // Far enough that far + cost cannot overflow; never improves a label
+    constexpr long long FAR = numeric_limits<long long>::max() / 4;
+    const size_t n = static_cast<size_t>(g.numNodes);
+
+    dist.assign(n * K, FAR);
+    pred.assign(n * K, NO_ARC);
+
+    // Nodes are scanned in order of their smallest label that dropped;
+    // key[v] is that label while v waits, FAR otherwise
+    using Entry = pair<long long, int>;
+    priority_queue<Entry, vector<Entry>, greater<Entry>> heap;
+    vector<long long> key(n, FAR);
+    for (size_t j = 0; j < sources.size() && j < K; ++j) {
+        int s = sources[j];
+        dist[s * K + j] = 0;
+        if (key[s] > 0) {
+            key[s] = 0;
+            heap.emplace(0, s);
+            EventCounters::add(Counter::HeapPushes);
+        }
+    }
+
+    while (!heap.empty()) {
+        auto [k, u] = heap.top();
+        heap.pop();
+        EventCounters::add(Counter::HeapPops);
+        if (k != key[u])
+            continue;
+        key[u] = FAR;
+        const long long *du = &dist[u * K];
+        for (size_t i = g.outBegin[u]; i < g.outBegin[u + 1]; ++i) {
+            size_t a = g.outArcs[i];
+            int v = g.target[a];
+            long long *dv = &dist[v * K];
+            size_t *pv = &pred[v * K];
+            const long long c = cost[a];
+            long long low = FAR;
+            for (size_t j = 0; j < K; ++j) {
+                long long d = du[j] + c;
+                bool better = d < dv[j];
+                dv[j] = better ? d : dv[j];
+                pv[j] = better ? a : pv[j];
+                low = better && d < low ? d : low;
+            }
+            if (low < key[v]) {
+                key[v] = low;
+                heap.emplace(low, v);
+                EventCounters::add(Counter::HeapPushes);
+            }
+        }
+    }
+
+    for (long long &d : dist)
+        if (d >= FAR)
+            d = unreachableDistance<long long>();
+}
+
+/**
+ * @brief Shortest paths from a batch of sources in an acyclic graph
+ * @param g Graph topology without directed cycles
+ * @param cond Components of g, all single nodes
+ * @param cost Cost per arc, negative costs allowed
+ * @param sources Up to MULTI_SOURCE_WIDTH start nodes
+ * @param dist Receives MULTI_SOURCE_WIDTH interleaved labels per node
+ * @param pred Receives the tree arcs in the same layout
+ */
+void acyclicDistances(const FlowGraph &g, const Condensation &cond,
+                      const vector<long long> &cost,
+                      const vector<int> &sources, vector<long long> &dist,
+                      vector<size_t> &pred) {
+    constexpr size_t K = MULTI_SOURCE_WIDTH;
+    const long long FAR = unreachableDistance<long long>();
+    const size_t n = static_cast<size_t>(g.numNodes);
+
+    dist.assign(n * K, FAR);
+    pred.assign(n * K, NO_ARC);
+    for (size_t j = 0; j < sources.size() && j < K; ++j)
+        dist[sources[j] * K + j] = 0;
+
+    // Predecessors come first in topological order, so their labels are
+    // final when a node pulls; unreached lanes must not take part
+    for (int v : cond.nodes) {
+        long long *dv = &dist[v * K];
+        size_t *pv = &pred[v * K];
+        for (size_t i = g.inBegin[v]; i < g.inBegin[v + 1]; ++i) {
+            size_t a = g.inArcs[i];
+            const long long *du = &dist[g.source[a] * K];
+            const long long c = cost[a];
+            for (size_t j = 0; j < K; ++j) {
+                bool reached = du[j] != FAR;
+                long long d = reached ? du[j] + c : FAR;
+                bool better = reached && d < dv[j];
+                dv[j] = better ? d : dv[j];
+                pv[j] = better ? a : pv[j];
+            }
+        }
+    }
+}
+
+/**
+ * @brief Fingerprint of a topology with integer costs
+ * @param g Graph topology
+ * @param cost Cost per arc
+ * @return 64-bit FNV-1a hash of the node count, arcs and costs
+ */
+uint64_t graphFingerprint(const FlowGraph &g, const vector<long long> &cost) {
+    uint64_t hash = 1469598103934665603ULL;
+    auto mix = [&](uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            hash ^= (value >> (8 * i)) & 0xff;
+            hash *= 1099511628211ULL;
+        }
+    };
+    mix(static_cast<uint64_t>(g.numNodes));
+    for (size_t a = 0; a < g.numArcs(); ++a) {
+        mix(static_cast<uint64_t>(g.source[a]));
+        mix(static_cast<uint64_t>(g.target[a]));
+        mix(static_cast<uint64_t>(cost[a]));
+    }
+    return hash;
+}
+
+/**
+ * @brief Create an empty cache
+ * @param budget Largest number of bytes of trees to keep
+ */
+DistanceCache::DistanceCache(size_t budget)
+    : maxBytes(budget), usedBytes(0), fingerprint(0) {}
+
+/**
+ * @brief Prepare the cache for a graph
+ * @param graph Fingerprint of the graph about to be searched
+ */
+void DistanceCache::bind(uint64_t graph) {
+    if (graph != fingerprint) {
+        clear();
+        fingerprint = graph;
+    }
+}
+
+/**
+ * @brief Look up the tree of a source
+ * @param source Source node (0-indexed)
+ * @return Cached tree, or nullptr
+ */
+const ShortestPathTree<long long> *DistanceCache::find(int source) const {
+    static MetricCounter &hits = Metrics::counter(
+        "networkflow_distance_cache_lookups_total",
+        "Shortest path tree lookups in distance caches", {{"result", "hit"}});
+    static MetricCounter &misses = Metrics::counter(
+        "networkflow_distance_cache_lookups_total",
+        "Shortest path tree lookups in distance caches",
+        {{"result", "miss"}});
+    lock_guard<std::mutex> lock(mutex);
+    auto it = trees.find(source);
+    (it == trees.end() ? misses : hits).add();
+    return it == trees.end() ? nullptr : &it->second;
+}
+
+/**
+ * @brief Store the tree of a source
+ * @param source Source node (0-indexed)
+ * @param tree Tree to keep
+ * @return False if the budget is exhausted and the tree was dropped
+ */
+bool DistanceCache::insert(int source, ShortestPathTree<long long> tree) {
+    size_t bytes = tree.dist.size() * sizeof(long long) +
+                   tree.pred.size() * sizeof(size_t);
+    lock_guard<std::mutex> lock(mutex);
+    if (trees.count(source))
+        return true;
+    if (usedBytes + bytes > maxBytes)
+        return false;
+    usedBytes += bytes;
+    trees.emplace(source, std::move(tree));
+    return true;
+}
+
+/**
+ * @brief Drop all trees
+ */
+void DistanceCache::clear() {
+    lock_guard<std::mutex> lock(mutex);
+    trees.clear();
+    usedBytes = 0;
+}
+
+/**
+ * @brief Number of cached trees
+ * @return Tree count
+ */
+size_t DistanceCache::size() const {
+    lock_guard<std::mutex> lock(mutex);
+    return trees.size();
+}
+
+/**
+ * @brief Find a cycle of negative total cost
+ * @param g Graph to search, using FlowGraph::cost
+ * @param threads Worker threads, 0 for hardware concurrency
+ * @return Arc indices of one negative cycle in traversal order, or an empty
+ *         vector if every cycle has nonnegative cost
+ */
+vector<size_t> findNegativeCycle(const FlowGraph &g, unsigned threads) {
+    if (none_of(g.cost.begin(), g.cost.end(), [](double c) { return c < 0; }))
+        return {};
+    return findNegativeCycle(g, Condensation(g), threads);
+}
+
+/**
+ * @brief Find a cycle of negative total cost inside components
+ * @param g Graph to search, using FlowGraph::cost
+ * @param cond Strongly connected components of g
+ * @param threads Worker threads, 0 for hardware concurrency
+ * @return Arc indices of one negative cycle in traversal order, or an empty
+ *         vector if every cycle has nonnegative cost
+ */
+vector<size_t> findNegativeCycle(const FlowGraph &g, const Condensation &cond,
+                                 unsigned threads) {
+    bool negative = false;
+    for (size_t a = 0; a < g.numArcs() && !negative; ++a)
+        negative = g.cost[a] < 0 &&
+                   cond.component[g.source[a]] == cond.component[g.target[a]];
+    if (!negative)
+        return {};
+
+    vector<double> zero(static_cast<size_t>(g.numNodes), 0.0);
+    if (workerCount(threads) == 1 || cond.largest() <= SERIAL_COMPONENT_NODES)
+        return condensedBellmanFord(g, cond, g.cost, std::move(zero), threads)
+            .negativeCycle;
+
+    // Searching the inner arcs alone keeps DAG arcs out of every round
+    vector<size_t> arcs;
+    FlowGraph inner = innerSubgraph(g, cond, arcs, threads);
+    vector<size_t> cycle =
+        bellmanFord(inner, inner.cost, std::move(zero), threads).negativeCycle;
+    for (size_t &a : cycle)
+        a = arcs[a];
+    return cycle;
+}
+
+template ShortestPathTree<double>
+deltaStepping(const FlowGraph &, const vector<double> &, const vector<int> &,
+              unsigned, double);
+template ShortestPathTree<long long>
+deltaStepping(const FlowGraph &, const vector<long long> &,
+              const vector<int> &, unsigned, long long);
+template ShortestPathTree<double>
+bellmanFord(const FlowGraph &, const vector<double> &, vector<double>,
+            unsigned);
+template ShortestPathTree<long long>
+bellmanFord(const FlowGraph &, const vector<long long> &, vector<long long>,
+            unsigned);
+template ShortestPathTree<double>
+condensedBellmanFord(const FlowGraph &, const Condensation &,
+                     const vector<double> &, vector<double>, unsigned);
+template ShortestPathTree<long long>
+condensedBellmanFord(const FlowGraph &, const Condensation &,
+                     const vector<long long> &, vector<long long>, unsigned);
@@ -0,0 +1,202 @@
+/**
+ * @file SimplexBasis.cpp
+ * @brief Construction and storage of simplex bases
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ *
+ * File format (native byte order): "NFBASIS1", uint32 version, uint64
+ * topology hash, uint64 node count, uint64 edge count, uint64 number of
+ * basic edges, then uint64 per basic edge and int32 per root node.
+ */
+
+#include "SimplexBasis.hpp"
+#include "FlowGraph.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+using namespace std;
+
+namespace {
+
+constexpr char MAGIC[8] = {'N', 'F', 'B', 'A', 'S', 'I', 'S', '1'};
+constexpr uint32_t VERSION = 1;
+
+/**
+ * @class BasisFile
+ * @brief Binary file that throws on short reads and writes
+ */
+class BasisFile {
+private:
+    std::FILE *file;
+    string path;
+
+public:
+    BasisFile(const string &filePath, const char *mode)
+        : file(std::fopen(filePath.c_str(), mode)), path(filePath) {
+        if (!file)
+            throw std::runtime_error("Cannot open basis file: " + path);
+    }
+
+    ~BasisFile() {
+        if (file)
+            std::fclose(file);
+    }
+
+    BasisFile(const BasisFile &) = delete;
+    BasisFile &operator=(const BasisFile &) = delete;
+
+    void write(const void *data, size_t bytes) {
+        if (bytes > 0 && std::fwrite(data, 1, bytes, file) != bytes)
+            throw std::runtime_error("Failed to write basis file: " + path);
+    }
+
+    void read(void *data, size_t bytes) {
+        if (bytes > 0 && std::fread(data, 1, bytes, file) != bytes)
+            throw std::runtime_error("Truncated basis file: " + path);
+    }
+
+    /**
+     * @brief Bytes between the read position and the end of the file
+     * @return Unread bytes
+     */
+    uint64_t remaining() {
+        const long here = std::ftell(file);
+        if (here < 0 || std::fseek(file, 0, SEEK_END) != 0)
+            throw std::runtime_error("Cannot seek in basis file: " + path);
+        const long end = std::ftell(file);
+        if (end < here || std::fseek(file, here, SEEK_SET) != 0)
+            throw std::runtime_error("Cannot seek in basis file: " + path);
+        return static_cast<uint64_t>(end - here);
+    }
+
+    template <typename T> void put(T value) { write(&value, sizeof(T)); }
+
+    template <typename T> T get() {
+        T value;
+        read(&value, sizeof(T));
+        return value;
+    }
+
+    void close() {
+        std::FILE *f = file;
+        file = nullptr;
+        if (std::fclose(f) != 0)
+            throw std::runtime_error("Failed to close basis file: " + path);
+    }
+};
+
+/**
+ * @brief Sort indices and check that they are distinct and below a limit
+ * @param values Indices, sorted in place
+ * @param limit One past the largest valid index
+ * @return True if every index is valid and appears once
+ */
+template <typename T> bool sortedUnique(vector<T> &values, uint64_t limit) {
+    sort(values.begin(), values.end());
+    for (size_t i = 0; i < values.size(); ++i) {
+        if constexpr (is_signed<T>::value)
+            if (values[i] < 0)
+                return false;
+        if (static_cast<uint64_t>(values[i]) >= limit ||
+            (i > 0 && values[i] == values[i - 1]))
+            return false;
+    }
+    return true;
+}
+
+} // namespace
+
+SimplexBasis::SimplexBasis() : hash(0), numNodes(0), numEdges(0) {}
+
+/**
+ * @brief Describe a basis of a network
+ * @param net Network the basis belongs to
+ * @param edges Basic edges
+ * @param rootNodes Nodes whose conservation row is basic (0-indexed)
+ * @throws std::invalid_argument If an index is out of range or repeated,
+ *         or the counts do not add up to the number of nodes
+ */
+SimplexBasis::SimplexBasis(const NetworkFlow &net, vector<size_t> edges,
+                           vector<int> rootNodes)
+    : hash(topologyHash(net)), numNodes(net.getNumNodes()),
+      numEdges(net.getNumEdges()), basicEdges(std::move(edges)),
+      roots(std::move(rootNodes)) {
+    if (basicEdges.size() + roots.size() != static_cast<size_t>(numNodes) ||
+        !sortedUnique(basicEdges, numEdges) || !sortedUnique(roots, numNodes))
+        throw std::invalid_argument("A basis needs one basic edge or root "
+                                    "per node");
+}
+
+/**
+ * @brief Read a basis written by save()
+ * @param path File to read
+ * @return Basis stored in the file
+ * @throws std::runtime_error If the file cannot be read or is invalid
+ */
+SimplexBasis SimplexBasis::load(const string &path) {
+    BasisFile in(path, "rb");
+    char magic[sizeof(MAGIC)];
+    in.read(magic, sizeof(magic));
+    if (memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        in.get<uint32_t>() != VERSION)
+        throw std::runtime_error("Not a basis file: " + path);
+
+    SimplexBasis basis;
+    basis.hash = in.get<uint64_t>();
+    const uint64_t n = in.get<uint64_t>();
+    const uint64_t m = in.get<uint64_t>();
+    const uint64_t basic = in.get<uint64_t>();
+    // Check the counts against the file before allocating for them
+    if (n > static_cast<uint64_t>(numeric_limits<int>::max()) || basic > n ||
+        basic > m ||
+        in.remaining() !=
+            basic * sizeof(uint64_t) + (n - basic) * sizeof(int32_t))
+        throw std::runtime_error("Invalid basis file: " + path);
+    basis.numNodes = static_cast<int>(n);
+    basis.numEdges = static_cast<size_t>(m);
+
+    vector<uint64_t> edges(basic);
+    vector<int32_t> roots(n - basic);
+    in.read(edges.data(), edges.size() * sizeof(uint64_t));
+    in.read(roots.data(), roots.size() * sizeof(int32_t));
+    if (!sortedUnique(edges, m) || !sortedUnique(roots, n))
+        throw std::runtime_error("Invalid basis file: " + path);
+
+    basis.basicEdges.assign(edges.begin(), edges.end());
+    basis.roots.assign(roots.begin(), roots.end());
+    return basis;
+}
+
+/**
+ * @brief Write the basis to a binary file
+ * @param path File to write
+ * @throws std::runtime_error If the file cannot be written
+ */
+void SimplexBasis::save(const string &path) const {
+    BasisFile out(path, "wb");
+    out.write(MAGIC, sizeof(MAGIC));
+    out.put<uint32_t>(VERSION);
+    out.put<uint64_t>(hash);
+    out.put<uint64_t>(static_cast<uint64_t>(numNodes));
+    out.put<uint64_t>(numEdges);
+    out.put<uint64_t>(basicEdges.size());
+    vector<uint64_t> edges(basicEdges.begin(), basicEdges.end());
+    vector<int32_t> nodes(roots.begin(), roots.end());
+    out.write(edges.data(), edges.size() * sizeof(uint64_t));
+    out.write(nodes.data(), nodes.size() * sizeof(int32_t));
+    out.close();
+}
+
+/**
+ * @brief Check whether the basis was taken from a network's topology
+ * @param net Network to check
+ * @return True if node count, edge count and topology hash match
+ */
+bool SimplexBasis::matches(const NetworkFlow &net) const {
+    return numNodes == net.getNumNodes() && numEdges == net.getNumEdges() &&
+           hash == topologyHash(net);
+}
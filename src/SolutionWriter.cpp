@@ -0,0 +1,362 @@
+/**
+ * @file SolutionWriter.cpp
+ * @brief Implementation of the buffered solution writers
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ */
+
+#include "SolutionWriter.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+/// Whether values are stored in the binary format's byte order already
+constexpr bool LITTLE_ENDIAN_HOST =
+    __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+
+/**
+ * @class OutputBuffer
+ * @brief Fixed-size byte buffer in front of a FILE stream
+ *
+ * Numbers are formatted in place with std::to_chars, so no temporary strings
+ * or locale lookups are involved. The buffer is handed to fwrite only when
+ * full, which keeps the number of system calls proportional to the output
+ * size divided by the buffer size.
+ */
+class OutputBuffer {
+private:
+    std::FILE *out;
+    vector<char> buffer;
+    size_t used;
+
+    void reserve(size_t n) {
+        if (buffer.size() - used < n)
+            flush();
+    }
+
+public:
+    OutputBuffer(std::FILE *f, size_t size)
+        : out(f), buffer(std::max<size_t>(size, 4096)), used(0) {}
+
+    void flush() {
+        if (used > 0 && std::fwrite(buffer.data(), 1, used, out) != used)
+            throw std::runtime_error("Failed to write solution output");
+        used = 0;
+    }
+
+    void put(char c) {
+        reserve(1);
+        buffer[used++] = c;
+    }
+
+    void put(const char *s, size_t n) {
+        if (n > buffer.size()) {
+            flush();
+            if (std::fwrite(s, 1, n, out) != n)
+                throw std::runtime_error("Failed to write solution output");
+            return;
+        }
+        reserve(n);
+        memcpy(buffer.data() + used, s, n);
+        used += n;
+    }
+
+    void put(const char *s) { put(s, strlen(s)); }
+
+    void put(const string &s) { put(s.data(), s.size()); }
+
+    template <typename T> void number(T value) {
+        // 32 bytes cover any shortest round-trip double or 64-bit integer
+        reserve(32);
+        auto res = std::to_chars(buffer.data() + used,
+                                 buffer.data() + buffer.size(), value);
+        used = static_cast<size_t>(res.ptr - buffer.data());
+    }
+
+    /// Append a value in little-endian byte order
+    template <typename T> void raw(const T &value) {
+        char bytes[sizeof(T)];
+        memcpy(bytes, &value, sizeof(T));
+        if (!LITTLE_ENDIAN_HOST)
+            std::reverse(bytes, bytes + sizeof(T));
+        put(bytes, sizeof(T));
+    }
+
+    /// Append an array of values in little-endian byte order
+    template <typename T> void column(const T *values, size_t count) {
+        if (!LITTLE_ENDIAN_HOST) {
+            for (size_t i = 0; i < count; ++i)
+                raw(values[i]);
+            return;
+        }
+        put(reinterpret_cast<const char *>(values), count * sizeof(T));
+    }
+};
+
+/**
+ * @brief Return the edge flows of a solution, checking them against the net
+ */
+const vector<double> &checkedFlows(const NetworkFlow &net,
+                                   const Solution &sol) {
+    if (sol.solved && sol.edgeFlows.size() != net.getNumEdges())
+        throw std::invalid_argument(
+            "Solution has " + to_string(sol.edgeFlows.size()) +
+            " edge flows, network has " + to_string(net.getNumEdges()) +
+            " edges");
+    return sol.edgeFlows;
+}
+
+/**
+ * @brief Append a string as a JSON string literal
+ */
+void putJsonString(OutputBuffer &buf, const string &s) {
+    static const char hex[] = "0123456789abcdef";
+    buf.put('"');
+    for (char c : s) {
+        unsigned char u = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\') {
+            buf.put('\\');
+            buf.put(c);
+        } else if (u < 0x20) {
+            char esc[6] = {'\\', 'u', '0', '0', hex[u >> 4], hex[u & 0xf]};
+            buf.put(esc, sizeof(esc));
+        } else {
+            buf.put(c);
+        }
+    }
+    buf.put('"');
+}
+
+/**
+ * @brief Append a double as a JSON number (non-finite values become null)
+ */
+void putJsonNumber(OutputBuffer &buf, double v) {
+    if (std::isfinite(v))
+        buf.number(v);
+    else
+        buf.put("null");
+}
+
+} // namespace
+
+SolutionWriter::SolutionWriter(const WriterOptions &opts) : options(opts) {}
+
+bool SolutionWriter::includes(double flow) const {
+    return !options.sparse || std::abs(flow) > options.zeroTolerance;
+}
+
+/**
+ * @brief Write a solution to a file
+ * @param net Network the solution belongs to
+ * @param sol Solution to export
+ * @param path Output file path, "-" writes to standard output
+ * @throws std::runtime_error If the file cannot be opened or written
+ *
+ * The stdio buffer is disabled because the writers already batch their
+ * output into large blocks.
+ */
+void SolutionWriter::write(const NetworkFlow &net, const Solution &sol,
+                           const string &path) const {
+    if (path == "-") {
+        write(net, sol, stdout);
+        std::fflush(stdout);
+        return;
+    }
+
+    std::FILE *out = std::fopen(path.c_str(), "wb");
+    if (!out)
+        throw std::runtime_error("Cannot open output file: " + path);
+    std::setvbuf(out, nullptr, _IONBF, 0);
+
+    try {
+        write(net, sol, out);
+    } catch (...) {
+        std::fclose(out);
+        throw;
+    }
+    if (std::fclose(out) != 0)
+        throw std::runtime_error("Failed to close output file: " + path);
+}
+
+/**
+ * @brief Write the solution as CSV
+ *
+ * Each row is "from,to,cost,flow" with nodes in 1-indexed form.
+ */
+void CsvSolutionWriter::write(const NetworkFlow &net, const Solution &sol,
+                              std::FILE *out) const {
+    const auto &flows = checkedFlows(net, sol);
+    OutputBuffer buf(out, options.bufferSize);
+
+    buf.put("from,to,cost,flow\n");
+    if (!flows.empty())
+        net.sweepEdges([&](const EdgeBlock &block) {
+            for (size_t i = 0; i < block.count; ++i) {
+                double flow = flows[block.first + i];
+                if (!includes(flow))
+                    continue;
+                buf.number(block.from[i]);
+                buf.put(',');
+                buf.number(block.to[i]);
+                buf.put(',');
+                buf.number(block.cost[i]);
+                buf.put(',');
+                buf.number(flow);
+                buf.put('\n');
+            }
+        });
+    buf.flush();
+}
+
+/**
+ * @brief Write the solution as a JSON document
+ */
+void JsonSolutionWriter::write(const NetworkFlow &net, const Solution &sol,
+                               std::FILE *out) const {
+    const auto &flows = checkedFlows(net, sol);
+    OutputBuffer buf(out, options.bufferSize);
+
+    buf.put("{\"status\":");
+    putJsonString(buf, sol.status);
+    buf.put(sol.solved ? ",\"solved\":true" : ",\"solved\":false");
+    buf.put(",\"totalCost\":");
+    putJsonNumber(buf, sol.totalCost);
+    buf.put(",\"numNodes\":");
+    buf.number(net.getNumNodes());
+    buf.put(",\"numEdges\":");
+    buf.number(net.getNumEdges());
+    buf.put(options.sparse ? ",\"sparse\":true" : ",\"sparse\":false");
+    buf.put(",\"flows\":[");
+
+    bool first = true;
+    if (!flows.empty())
+        net.sweepEdges([&](const EdgeBlock &block) {
+            for (size_t i = 0; i < block.count; ++i) {
+                size_t edge = block.first + i;
+                if (!includes(flows[edge]))
+                    continue;
+                buf.put(first ? "\n{\"edge\":" : ",\n{\"edge\":");
+                buf.number(edge);
+                buf.put(",\"from\":");
+                buf.number(block.from[i]);
+                buf.put(",\"to\":");
+                buf.number(block.to[i]);
+                buf.put(",\"cost\":");
+                putJsonNumber(buf, block.cost[i]);
+                buf.put(",\"flow\":");
+                putJsonNumber(buf, flows[edge]);
+                buf.put('}');
+                first = false;
+            }
+        });
+    buf.put("]}\n");
+    buf.flush();
+}
+
+/**
+ * @brief Write the solution in the columnar binary format
+ *
+ * Sparse mode first collects the indices of the nonzero edges, so every
+ * column is then written with a single sequential pass; the node columns
+ * take one edge sweep each.
+ */
+void BinarySolutionWriter::write(const NetworkFlow &net, const Solution &sol,
+                                 std::FILE *out) const {
+    const auto &flows = checkedFlows(net, sol);
+    OutputBuffer buf(out, options.bufferSize);
+
+    vector<uint64_t> rows;
+    if (options.sparse) {
+        for (size_t i = 0; i < flows.size(); ++i)
+            if (includes(flows[i]))
+                rows.push_back(i);
+    }
+    const uint64_t numRows = options.sparse ? rows.size() : flows.size();
+
+    buf.put("NFSOLBIN");
+    buf.raw<uint32_t>(1);
+    buf.raw<uint32_t>((options.sparse ? 1u : 0u) | (sol.solved ? 2u : 0u));
+    buf.raw<uint64_t>(static_cast<uint64_t>(net.getNumNodes()));
+    buf.raw<uint64_t>(numRows);
+    buf.raw<double>(sol.totalCost);
+    buf.raw<uint32_t>(static_cast<uint32_t>(sol.status.size()));
+    buf.put(sol.status);
+
+    // Node column of the written rows, picked from every block in turn
+    auto putNodes = [&](const int *EdgeBlock::*column) {
+        if (flows.empty())
+            return;
+        size_t next = 0;
+        net.sweepEdges([&](const EdgeBlock &block) {
+            const int *nodes = block.*column;
+            if (!options.sparse) {
+                for (size_t i = 0; i < block.count; ++i)
+                    buf.raw<int32_t>(nodes[i]);
+                return;
+            }
+            for (; next < rows.size() && rows[next] < block.first + block.count;
+                 ++next)
+                buf.raw<int32_t>(nodes[rows[next] - block.first]);
+        });
+    };
+
+    if (options.sparse) {
+        buf.column(rows.data(), rows.size());
+        putNodes(&EdgeBlock::from);
+        putNodes(&EdgeBlock::to);
+        for (uint64_t i : rows)
+            buf.raw<double>(flows[i]);
+    } else {
+        putNodes(&EdgeBlock::from);
+        putNodes(&EdgeBlock::to);
+        buf.column(flows.data(), flows.size());
+    }
+    buf.flush();
+}
+
+/**
+ * @brief Create a writer for the requested format
+ * @param format Output format
+ * @param opts Writer options
+ * @return Owning pointer to the writer
+ */
+unique_ptr<SolutionWriter> makeSolutionWriter(OutputFormat format,
+                                              const WriterOptions &opts) {
+    switch (format) {
+    case OutputFormat::Csv:
+        return make_unique<CsvSolutionWriter>(opts);
+    case OutputFormat::Json:
+        return make_unique<JsonSolutionWriter>(opts);
+    case OutputFormat::Binary:
+        return make_unique<BinarySolutionWriter>(opts);
+    }
+    throw std::invalid_argument("Unknown output format");
+}
+
+/**
+ * @brief Guess the output format from a file name extension
+ * @param path File name ending in .csv, .json or .bin
+ * @return Matching output format
+ * @throws std::invalid_argument If the extension is not recognised
+ */
+OutputFormat formatFromPath(const string &path) {
+    auto endsWith = [&](const char *ext) {
+        size_t n = strlen(ext);
+        return path.size() >= n && path.compare(path.size() - n, n, ext) == 0;
+    };
+    if (endsWith(".csv"))
+        return OutputFormat::Csv;
+    if (endsWith(".json"))
+        return OutputFormat::Json;
+    if (endsWith(".bin"))
+        return OutputFormat::Binary;
+    throw std::invalid_argument("Unknown output format for file: " + path);
+}
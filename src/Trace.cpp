@@ -0,0 +1,304 @@
+/**
+ * @file Trace.cpp
+ * @brief Per-thread trace ring buffers and their Chrome trace dump
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ *
+ * Each buffer has a single writer, its owning thread, which fills a slot
+ * and then publishes it by storing the slot's sequence number. A dump
+ * reads a slot's sequence number before and after copying it and drops
+ * the slot if the two differ, like a seqlock, so recording never waits.
+ *
+ * start() only bumps a generation counter; each owner clears its buffer
+ * the next time it records, under the registry lock, so buffers are never
+ * resized under a running dump.
+ */
+
+#include "Trace.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+std::atomic<bool> Trace::active(false);
+
+namespace {
+
+/**
+ * @struct TraceSlot
+ * @brief One event; every field is atomic so dumps can race with writes
+ */
+struct TraceSlot {
+    atomic<uint64_t> sequence{0}; ///< Event index + 1, 0 while written
+    atomic<const char *> name{nullptr};
+    atomic<const char *> category{nullptr};
+    atomic<const char *> detail{nullptr};
+    atomic<int64_t> begin{0};
+    atomic<int64_t> end{0};
+};
+
+/**
+ * @struct TraceBuffer
+ * @brief Ring buffer of one thread
+ */
+struct TraceBuffer {
+    unsigned id;
+    uint64_t generation = 0;
+    size_t capacity = 0;
+    unique_ptr<TraceSlot[]> slots;
+    atomic<uint64_t> head{0}; ///< Events recorded in this generation
+
+    explicit TraceBuffer(unsigned bufferId) : id(bufferId) {}
+};
+
+/**
+ * @class TraceRegistry
+ * @brief Owner of all buffers, handing them to threads
+ */
+class TraceRegistry {
+private:
+    mutex lock;
+    vector<unique_ptr<TraceBuffer>> buffers;
+    vector<TraceBuffer *> idle;
+    atomic<uint64_t> generation{1};
+    size_t capacity = Trace::DEFAULT_EVENTS;
+    chrono::steady_clock::time_point epoch = chrono::steady_clock::now();
+
+public:
+    void restart(size_t eventsPerThread) {
+        lock_guard<mutex> guard(lock);
+        capacity = max<size_t>(eventsPerThread, 1);
+        generation.fetch_add(1, memory_order_release);
+    }
+
+    int64_t now() const {
+        return chrono::duration_cast<chrono::nanoseconds>(
+                   chrono::steady_clock::now() - epoch)
+            .count();
+    }
+
+    TraceBuffer *acquire() {
+        lock_guard<mutex> guard(lock);
+        if (!idle.empty()) {
+            TraceBuffer *buffer = idle.back();
+            idle.pop_back();
+            return buffer;
+        }
+        buffers.push_back(
+            make_unique<TraceBuffer>(static_cast<unsigned>(buffers.size()) +
+                                     1));
+        return buffers.back().get();
+    }
+
+    void release(TraceBuffer *buffer) {
+        lock_guard<mutex> guard(lock);
+        idle.push_back(buffer);
+    }
+
+    /**
+     * @brief Make a buffer ready for events of the current generation
+     * @param buffer Buffer owned by the calling thread
+     */
+    void refresh(TraceBuffer &buffer) {
+        const uint64_t current = generation.load(memory_order_acquire);
+        if (buffer.generation == current)
+            return;
+        lock_guard<mutex> guard(lock);
+        if (buffer.capacity != capacity) {
+            buffer.slots = make_unique<TraceSlot[]>(capacity);
+            buffer.capacity = capacity;
+        }
+        buffer.head.store(0, memory_order_relaxed);
+        buffer.generation = generation.load(memory_order_relaxed);
+    }
+
+    template <typename F> void forEachEvent(F &&fn) {
+        lock_guard<mutex> guard(lock);
+        const uint64_t current = generation.load(memory_order_relaxed);
+        for (const auto &buffer : buffers) {
+            if (buffer->generation != current)
+                continue;
+            const uint64_t head = buffer->head.load(memory_order_acquire);
+            const uint64_t first =
+                head > buffer->capacity ? head - buffer->capacity : 0;
+            for (uint64_t i = first; i < head; ++i) {
+                const TraceSlot &slot = buffer->slots[i % buffer->capacity];
+                if (slot.sequence.load(memory_order_acquire) != i + 1)
+                    continue;
+                const char *name = slot.name.load(memory_order_relaxed);
+                const char *category =
+                    slot.category.load(memory_order_relaxed);
+                const char *detail = slot.detail.load(memory_order_relaxed);
+                const int64_t begin = slot.begin.load(memory_order_relaxed);
+                const int64_t end = slot.end.load(memory_order_relaxed);
+                atomic_thread_fence(memory_order_acquire);
+                if (slot.sequence.load(memory_order_relaxed) != i + 1)
+                    continue; // Overwritten while copying
+                fn(buffer->id, name, category, detail, begin, end);
+            }
+        }
+    }
+
+    template <typename F> void forEachThread(F &&fn) {
+        lock_guard<mutex> guard(lock);
+        const uint64_t current = generation.load(memory_order_relaxed);
+        for (const auto &buffer : buffers)
+            if (buffer->generation == current)
+                fn(buffer->id);
+    }
+};
+
+TraceRegistry &registry() {
+    static TraceRegistry instance;
+    return instance;
+}
+
+/**
+ * @struct ThreadTrace
+ * @brief Buffer of the current thread, returned to the registry at exit
+ */
+struct ThreadTrace {
+    TraceBuffer *buffer = nullptr;
+
+    ~ThreadTrace() {
+        if (buffer)
+            registry().release(buffer);
+    }
+};
+
+thread_local ThreadTrace threadTrace;
+
+/**
+ * @brief Append a JSON string literal with escaping
+ * @param out Output text
+ * @param text Text to quote
+ */
+void appendQuoted(string &out, const char *text) {
+    out += '"';
+    for (const char *c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\')
+            out += '\\';
+        if (static_cast<unsigned char>(*c) >= 0x20)
+            out += *c;
+    }
+    out += '"';
+}
+
+/**
+ * @brief Append nanoseconds as microseconds, the Chrome trace time unit
+ * @param out Output text
+ * @param ns Time in nanoseconds
+ */
+void appendMicros(string &out, int64_t ns) {
+    char text[32];
+    snprintf(text, sizeof(text), "%lld.%03lld",
+             static_cast<long long>(ns / 1000),
+             static_cast<long long>(ns % 1000));
+    out += text;
+}
+
+} // namespace
+
+/**
+ * @brief Discard recorded events and start tracing
+ * @param eventsPerThread Ring buffer capacity of each thread
+ */
+void Trace::start(size_t eventsPerThread) {
+    registry().restart(eventsPerThread);
+    active.store(true, memory_order_relaxed);
+}
+
+/**
+ * @brief Stop tracing, keeping the recorded events for write()
+ */
+void Trace::stop() { active.store(false, memory_order_relaxed); }
+
+/**
+ * @brief Current time on the trace clock
+ * @return Nanoseconds since the trace clock started
+ */
+int64_t Trace::now() { return registry().now(); }
+
+/**
+ * @brief Record a complete event on the calling thread's buffer
+ * @param name Event name, a string literal or otherwise never freed
+ * @param category Event category, same lifetime rule
+ * @param detail Optional argument shown with the event, or null
+ * @param begin Start time from now()
+ * @param end End time from now()
+ */
+void Trace::record(const char *name, const char *category,
+                   const char *detail, int64_t begin, int64_t end) {
+    TraceBuffer *&buffer = threadTrace.buffer;
+    if (!buffer)
+        buffer = registry().acquire();
+    registry().refresh(*buffer);
+
+    const uint64_t index = buffer->head.load(memory_order_relaxed);
+    TraceSlot &slot = buffer->slots[index % buffer->capacity];
+    slot.sequence.store(0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    slot.name.store(name, memory_order_relaxed);
+    slot.category.store(category, memory_order_relaxed);
+    slot.detail.store(detail, memory_order_relaxed);
+    slot.begin.store(begin, memory_order_relaxed);
+    slot.end.store(end, memory_order_relaxed);
+    slot.sequence.store(index + 1, memory_order_release);
+    buffer->head.store(index + 1, memory_order_release);
+}
+
+/**
+ * @brief Write the recorded events as Chrome trace JSON
+ * @param path File to write
+ * @throws std::runtime_error If the file cannot be written
+ */
+void Trace::write(const string &path) {
+    string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    auto separate = [&]() {
+        if (!first)
+            out += ',';
+        first = false;
+        out += '\n';
+    };
+
+    registry().forEachThread([&](unsigned tid) {
+        separate();
+        out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" +
+               to_string(tid) + ",\"args\":{\"name\":\"thread " +
+               to_string(tid) + "\"}}";
+    });
+    registry().forEachEvent([&](unsigned tid, const char *name,
+                                const char *category, const char *detail,
+                                int64_t begin, int64_t end) {
+        separate();
+        out += "{\"name\":";
+        appendQuoted(out, name);
+        out += ",\"cat\":";
+        appendQuoted(out, category);
+        out += ",\"ph\":\"X\",\"ts\":";
+        appendMicros(out, begin);
+        out += ",\"dur\":";
+        appendMicros(out, end - begin);
+        out += ",\"pid\":1,\"tid\":" + to_string(tid);
+        if (detail) {
+            out += ",\"args\":{\"detail\":";
+            appendQuoted(out, detail);
+            out += '}';
+        }
+        out += '}';
+    });
+    out += "\n]}\n";
+
+    std::FILE *file = std::fopen(path.c_str(), "wb");
+    if (!file)
+        throw std::runtime_error("Cannot open trace file: " + path);
+    bool written = std::fwrite(out.data(), 1, out.size(), file) == out.size();
+    if (std::fclose(file) != 0 || !written)
+        throw std::runtime_error("Failed to write trace file: " + path);
+}
@@ -0,0 +1,381 @@
+/**
+ * @file TransportationSolver.cpp
+ * @brief Implementation of the shortest path transportation solver
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ *
+ * Costs are first made nonnegative with base potentials p (c + p_u - p_v
+ * >= 0, found by Bellman-Ford when some cost is negative). Path lengths d
+ * below are measured in these reduced costs; this shifts every route from
+ * s to t by the same p_t - p_s, so the optimal shipments do not change.
+ *
+ * With transportation duals q (q_t <= q_s + d(s, t), equality when s ships
+ * to t), pi_v = min_s (q_s + d(s, v)) are optimal potentials of the whole
+ * network: every arc satisfies the triangle inequality, and arcs on a used
+ * shortest path from s to t are tight.
+ *
+ * With a contraction hierarchy, lengths and paths come from point-to-point
+ * queries, and pi is one Bellman-Ford run from labels q_s at the supplies.
+ * On acyclic networks both Bellman-Ford runs and the trees are single
+ * passes in topological order.
+ *
+ * A single supply node needs no transportation problem: it ships every
+ * demand along its tree, and pi = d(s, v) with q_s = 0. That tree is the
+ * only search of the solve, so on large cyclic graphs it runs in parallel
+ * with delta-stepping.
+ */
+
+#include "TransportationSolver.hpp"
+#include "ContractionHierarchy.hpp"
+#include "NativeSolver.hpp"
+#include "Parallel.hpp"
+#include "ShortestPath.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <mutex>
+
+using namespace std;
+
+namespace {
+
+/**
+ * @brief Flows shipping every demand from one supply node along its tree
+ * @param g Graph topology
+ * @param tree Shortest path tree of the supply node
+ * @param supply Scaled balance per node
+ * @param root Supply node
+ * @return Flow per arc: each tree arc carries the demand of its subtree
+ *
+ * Nodes are put in breadth-first order from the root through per-node
+ * child lists, so the subtree sums take one backward pass instead of one
+ * path walk per demand.
+ */
+vector<long long> treeFlows(const FlowGraph &g,
+                            const ShortestPathTree<long long> &tree,
+                            const vector<long long> &supply, int root) {
+    const size_t n = static_cast<size_t>(g.numNodes);
+    vector<size_t> childBegin(n + 1, 0);
+    for (size_t v = 0; v < n; ++v)
+        if (tree.pred[v] != NO_ARC)
+            ++childBegin[g.source[tree.pred[v]] + 1];
+    for (size_t v = 0; v < n; ++v)
+        childBegin[v + 1] += childBegin[v];
+    vector<int> children(childBegin[n]);
+    vector<size_t> next(childBegin.begin(), childBegin.end() - 1);
+    for (size_t v = 0; v < n; ++v)
+        if (tree.pred[v] != NO_ARC)
+            children[next[g.source[tree.pred[v]]]++] = static_cast<int>(v);
+
+    vector<int> order{root};
+    for (size_t i = 0; i < order.size(); ++i)
+        for (size_t k = childBegin[order[i]]; k < childBegin[order[i] + 1];
+             ++k)
+            order.push_back(children[k]);
+
+    vector<long long> flow(g.numArcs(), 0), below(n, 0);
+    for (size_t i = order.size(); i-- > 1;) {
+        const int v = order[i];
+        const size_t a = tree.pred[v];
+        flow[a] = below[v] - supply[v];
+        below[g.source[a]] += flow[a];
+    }
+    return flow;
+}
+
+/**
+ * @brief Make potentials finite and undo the base potentials
+ * @param potential Potentials in reduced costs, FAR where no supply reaches
+ * @param base Base potentials the costs were reduced with
+ */
+void finishPotentials(vector<long long> &potential,
+                      const vector<long long> &base) {
+    const long long FAR = unreachableDistance<long long>();
+    // Nodes no supply reaches carry no flow; any large enough value works
+    long long highest = 0;
+    for (long long p : potential)
+        if (p != FAR)
+            highest = max(highest, p);
+    for (size_t v = 0; v < potential.size(); ++v)
+        potential[v] = (potential[v] == FAR ? highest : potential[v]) + base[v];
+}
+
+} // namespace
+
+/**
+ * @brief Construct a solver for a network
+ * @param network Network to solve, must outlive the solver
+ */
+TransportationSolver::TransportationSolver(const NetworkFlow &network)
+    : net(network) {}
+
+/**
+ * @brief Check whether a network takes the linear acyclic path
+ * @param network Network to check
+ * @param threads Worker threads for building the graph
+ * @return True if the network has no directed cycle and at most one
+ *         supply node
+ *
+ * More supply nodes need a transportation problem between supplies and
+ * demands, which is not linear in their product. The cycle check needs the
+ * whole graph in memory, so networks whose edges live in an edge store are
+ * never routed here.
+ */
+bool TransportationSolver::linearOnAcyclic(const NetworkFlow &network,
+                                           unsigned threads) {
+    if (network.getEdgeStore())
+        return false;
+    size_t supplies = 0;
+    for (int v = 1; v <= network.getNumNodes(); ++v)
+        if (network.getBalance(v) > 0 && ++supplies > 1)
+            return false;
+    return Condensation(FlowGraph(network, threads)).acyclic();
+}
+
+/**
+ * @brief Solve the network
+ * @param options Solve options (threads, distance cache, hierarchy)
+ * @return Solution with flows and optimal potentials
+ *
+ * Returns status "Infeasible" or "Unbounded" without flows when the network
+ * has no optimal solution, and explains why if the data cannot be scaled to
+ * integers.
+ */
+Solution TransportationSolver::solve(const SolveOptions &options) const {
+    using Tree = ShortestPathTree<long long>;
+    constexpr size_t K = MULTI_SOURCE_WIDTH;
+    const long long FAR = unreachableDistance<long long>();
+
+    Solution result;
+    // A hierarchy only matches the graph in the network's own numbering
+    IntegralInstance inst(net, options.threads,
+                          options.hierarchy ? NodeOrder::Original
+                                            : options.nodeOrder);
+    if (!nativePrecheck(net, inst, result, options.threads))
+        return result;
+    TraceScope trace("transportation", "engine");
+
+    const FlowGraph &g = inst.graph;
+    const size_t n = static_cast<size_t>(g.numNodes);
+    const size_t m = g.numArcs();
+
+    vector<long long> base(n, 0);
+    if (any_of(inst.cost.begin(), inst.cost.end(),
+               [](long long c) { return c < 0; }))
+        base = condensedBellmanFord(g, inst.condensation, inst.cost, base,
+                                    options.threads)
+                   .dist;
+    vector<long long> cost(m);
+    for (size_t a = 0; a < m; ++a)
+        cost[a] = inst.cost[a] + base[g.source[a]] - base[g.target[a]];
+
+    vector<int> supplies, demands;
+    for (size_t v = 0; v < n; ++v) {
+        if (inst.supply[v] > 0)
+            supplies.push_back(static_cast<int>(v));
+        else if (inst.supply[v] < 0)
+            demands.push_back(static_cast<int>(v));
+    }
+    if (supplies.empty())
+        return nativeSolution(net, inst, vector<long long>(m, 0), base);
+
+    shared_ptr<const ContractionHierarchy> hierarchy = options.hierarchy;
+    if (hierarchy && (hierarchy->empty() || !hierarchy->matches(g)))
+        hierarchy.reset();
+    HierarchyMetric metric;
+    vector<HierarchySearch> toDemand;
+
+    shared_ptr<DistanceCache> cache = options.distanceCache;
+    if (!cache)
+        cache = make_shared<DistanceCache>();
+    if (!hierarchy)
+        cache->bind(graphFingerprint(g, inst.cost));
+
+    // Visit the trees of one batch of supply nodes, computing missing ones.
+    // A lone search on a large cyclic graph uses all threads itself.
+    const size_t batches = (supplies.size() + K - 1) / K;
+    const bool parallelSearch = supplies.size() == 1 &&
+                                !inst.condensation.acyclic() &&
+                                n >= PARALLEL_SEARCH_NODES;
+    auto forEachTree = [&](size_t batch, auto &&visit) {
+        vector<int> missing;
+        vector<size_t> missingIndex;
+        for (size_t i = batch * K; i < min(supplies.size(), (batch + 1) * K);
+             ++i) {
+            if (const Tree *tree = cache->find(supplies[i])) {
+                visit(i, *tree);
+            } else {
+                missing.push_back(supplies[i]);
+                missingIndex.push_back(i);
+            }
+        }
+        if (missing.empty())
+            return;
+        if (parallelSearch) {
+            Tree tree = deltaStepping(g, cost, missing, options.threads);
+            visit(missingIndex[0], tree);
+            cache->insert(missing[0], std::move(tree));
+            return;
+        }
+
+        vector<long long> dist;
+        vector<size_t> pred;
+        if (inst.condensation.acyclic())
+            acyclicDistances(g, inst.condensation, cost, missing, dist, pred);
+        else
+            multiSourceDistances(g, cost, missing, dist, pred);
+        for (size_t j = 0; j < missing.size(); ++j) {
+            Tree tree;
+            tree.dist.resize(n);
+            tree.pred.resize(n);
+            for (size_t v = 0; v < n; ++v) {
+                tree.dist[v] = dist[v * K + j];
+                tree.pred[v] = pred[v * K + j];
+            }
+            visit(missingIndex[j], tree);
+            cache->insert(missing[j], std::move(tree));
+        }
+    };
+
+    // One supply node: ship along its tree without a transportation problem
+    if (supplies.size() == 1 && !hierarchy) {
+        vector<long long> flow, potential;
+        bool reachable = false;
+        forEachTree(0, [&](size_t, const Tree &tree) {
+            for (int t : demands)
+                if (tree.dist[t] == FAR)
+                    return;
+            reachable = true;
+            flow = treeFlows(g, tree, inst.supply, supplies[0]);
+            potential = tree.dist;
+        });
+        if (!reachable) {
+            result.status = "Infeasible";
+            return result;
+        }
+        finishPotentials(potential, base);
+        return nativeSolution(net, inst, flow, potential);
+    }
+
+    // Path lengths between every supply and demand node
+    const size_t numDemands = demands.size();
+    vector<long long> length(supplies.size() * numDemands);
+    if (hierarchy) {
+        metric = hierarchy->customize(g, cost);
+        toDemand.resize(numDemands);
+        parallelTasks(numDemands, options.threads, [&](size_t k) {
+            hierarchy->search(metric, demands[k], false, toDemand[k]);
+        });
+        parallelTasks(supplies.size(), options.threads, [&](size_t i) {
+            HierarchySearch from;
+            hierarchy->search(metric, supplies[i], true, from);
+            for (size_t k = 0; k < numDemands; ++k)
+                length[i * numDemands + k] =
+                    hierarchy->distance(from, toDemand[k]);
+        });
+    } else {
+        parallelTasks(batches, options.threads, [&](size_t batch) {
+            forEachTree(batch, [&](size_t i, const Tree &tree) {
+                for (size_t k = 0; k < numDemands; ++k)
+                    length[i * numDemands + k] = tree.dist[demands[k]];
+            });
+        });
+    }
+
+    // Transportation problem on the scaled data
+    const int numSupplies = static_cast<int>(supplies.size());
+    NetworkFlow transport(numSupplies + static_cast<int>(numDemands));
+    for (int i = 0; i < numSupplies; ++i)
+        transport.setBalance(i + 1,
+                             static_cast<double>(inst.supply[supplies[i]]));
+    for (size_t k = 0; k < numDemands; ++k)
+        transport.setBalance(numSupplies + static_cast<int>(k) + 1,
+                             static_cast<double>(inst.supply[demands[k]]));
+    vector<size_t> route;
+    for (size_t p = 0; p < length.size(); ++p) {
+        if (length[p] == FAR)
+            continue;
+        transport.addEdge(static_cast<int>(p / numDemands) + 1,
+                          numSupplies + static_cast<int>(p % numDemands) + 1,
+                          static_cast<double>(length[p]));
+        route.push_back(p);
+    }
+
+    SolveOptions planOptions;
+    planOptions.backend = SolverBackend::CapacityScaling;
+    planOptions.threads = options.threads;
+    // The plan is itself acyclic; it must not come back here
+    planOptions.acyclicShortcut = false;
+    Solution plan = transport.solve(planOptions);
+    if (!plan.solved) {
+        result.status = plan.status;
+        return result;
+    }
+
+    vector<long long> shipped(length.size(), 0);
+    for (size_t e = 0; e < route.size(); ++e)
+        shipped[route[e]] = llround(plan.edgeFlows[e]);
+
+    // Route shipments along the trees and take potentials from the duals
+    vector<long long> flow(m, 0), potential(n, FAR);
+    mutex merge;
+    if (hierarchy) {
+        parallelTasks(supplies.size(), options.threads, [&](size_t i) {
+            HierarchySearch from;
+            vector<size_t> arcs;
+            vector<pair<size_t, long long>> adds;
+            hierarchy->search(metric, supplies[i], true, from);
+            for (size_t k = 0; k < numDemands; ++k) {
+                long long amount = shipped[i * numDemands + k];
+                if (amount == 0)
+                    continue;
+                arcs.clear();
+                hierarchy->path(metric, from, toDemand[k], arcs);
+                for (size_t a : arcs)
+                    adds.emplace_back(a, amount);
+            }
+
+            lock_guard<mutex> lock(merge);
+            for (const auto &add : adds)
+                flow[add.first] += add.second;
+        });
+        for (size_t i = 0; i < supplies.size(); ++i)
+            potential[supplies[i]] = min(potential[supplies[i]],
+                                         llround(plan.potentials[i]));
+        potential = condensedBellmanFord(g, inst.condensation, cost,
+                                         std::move(potential),
+                                         options.threads)
+                        .dist;
+    } else {
+        parallelTasks(batches, options.threads, [&](size_t batch) {
+            vector<pair<size_t, long long>> adds;
+            vector<long long> local(n, FAR);
+            forEachTree(batch, [&](size_t i, const Tree &tree) {
+                long long q = llround(plan.potentials[i]);
+                for (size_t v = 0; v < n; ++v)
+                    if (tree.dist[v] != FAR)
+                        local[v] = min(local[v], q + tree.dist[v]);
+                for (size_t k = 0; k < numDemands; ++k) {
+                    long long amount = shipped[i * numDemands + k];
+                    if (amount == 0)
+                        continue;
+                    for (int v = demands[k]; v != supplies[i];) {
+                        size_t a = tree.pred[v];
+                        adds.emplace_back(a, amount);
+                        v = g.source[a];
+                    }
+                }
+            });
+
+            lock_guard<mutex> lock(merge);
+            for (const auto &add : adds)
+                flow[add.first] += add.second;
+            for (size_t v = 0; v < n; ++v)
+                potential[v] = min(potential[v], local[v]);
+        });
+    }
+
+    finishPotentials(potential, base);
+    return nativeSolution(net, inst, flow, potential);
+}
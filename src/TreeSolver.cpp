@@ -0,0 +1,125 @@
+/**
+ * @file TreeSolver.cpp
+ * @brief Implementation of the closed-form forest solver
+ * @author Abir Chakraborty Partha
+ * @date 17 Oct, 2026
+ */
+
+#include "TreeSolver.hpp"
+#include "FlowGraph.hpp"
+#include "ShortestPath.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+/**
+ * @brief Construct a solver for a network
+ * @param network Network to solve, must outlive the solver
+ */
+TreeSolver::TreeSolver(const NetworkFlow &network) : net(network) {}
+
+/**
+ * @brief Solve the network if it is a forest
+ * @param options Solve options (threads)
+ * @param result Receives the solution, optimal or "Infeasible"
+ * @return False, leaving result untouched, if the network has a cycle
+ *         when edge directions are ignored
+ */
+bool TreeSolver::solve(const SolveOptions &options, Solution &result) const {
+    const int n = net.getNumNodes();
+    // A forest has fewer edges than nodes; decide without building a graph
+    if (net.getNumEdges() >= static_cast<size_t>(max(n, 1)))
+        return false;
+
+    TraceScope trace("tree", "engine");
+    const FlowGraph g(net, options.threads);
+    const size_t m = g.numArcs();
+
+    // Breadth-first order of every tree, with the edge towards the root
+    vector<int> order;
+    order.reserve(n);
+    vector<size_t> parentArc(n, NO_ARC);
+    vector<char> seen(n, 0);
+    size_t trees = 0;
+    for (int root = 0; root < n; ++root) {
+        if (seen[root])
+            continue;
+        ++trees;
+        seen[root] = 1;
+        order.push_back(root);
+        for (size_t i = order.size() - 1; i < order.size(); ++i) {
+            const int u = order[i];
+            auto reach = [&](size_t a, int w) {
+                if (seen[w])
+                    return;
+                seen[w] = 1;
+                parentArc[w] = a;
+                order.push_back(w);
+            };
+            for (size_t k = g.outBegin[u]; k < g.outBegin[u + 1]; ++k)
+                reach(g.outArcs[k], g.target[g.outArcs[k]]);
+            for (size_t k = g.inBegin[u]; k < g.inBegin[u + 1]; ++k)
+                reach(g.inArcs[k], g.source[g.inArcs[k]]);
+        }
+    }
+    // Each tree has one edge fewer than nodes; loops and parallel edges
+    // close cycles and break the count
+    if (m + trees != static_cast<size_t>(n))
+        return false;
+
+    result = Solution();
+    vector<double> subtree(n);
+    double total = 0.0;
+    for (int v = 0; v < n; ++v) {
+        subtree[v] = net.getBalance(v + 1);
+        total += std::abs(subtree[v]);
+    }
+    const double tol = 1e-9 * max(1.0, total);
+
+    // Children before parents: the subtree of v sends its net supply over
+    // the edge to its parent
+    result.edgeFlows.assign(m, 0.0);
+    for (size_t i = order.size(); i-- > 0;) {
+        const int v = order[i];
+        const size_t a = parentArc[v];
+        if (a == NO_ARC) {
+            if (std::abs(subtree[v]) > tol) {
+                result.status = "Infeasible";
+                return true;
+            }
+            continue;
+        }
+        const bool up = g.source[a] == v;
+        const double x = up ? subtree[v] : -subtree[v];
+        if (x < -tol) {
+            result.status = "Infeasible";
+            return true;
+        }
+        result.edgeFlows[a] = max(x, 0.0);
+        subtree[up ? g.target[a] : g.source[a]] += subtree[v];
+    }
+
+    // Parents before children: every edge gets zero reduced cost
+    result.potentials.assign(n, 0.0);
+    for (int v : order) {
+        const size_t a = parentArc[v];
+        if (a == NO_ARC)
+            continue;
+        if (g.target[a] == v)
+            result.potentials[v] = result.potentials[g.source[a]] + g.cost[a];
+        else
+            result.potentials[v] = result.potentials[g.target[a]] - g.cost[a];
+    }
+
+    for (size_t a = 0; a < m; ++a) {
+        const double x = result.edgeFlows[a];
+        result.totalCost += g.cost[a] * x;
+        if (x > 1e-6)
+            result.flows[{g.source[a] + 1, g.target[a] + 1}] += x;
+    }
+    result.solved = true;
+    result.status = "Optimal";
+    return true;
+}
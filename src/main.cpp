@@ -10,70 +10,340 @@
  */
 
 #include <iostream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "AllocationTracker.hpp"
+#include "ContractionHierarchy.hpp"
+#include "FlowGraph.hpp"
+#include "InstanceReader.hpp"
+#include "Metrics.hpp"
 #include "NetworkFlow.hpp"
+#include "SimplexBasis.hpp"
+#include "SolutionWriter.hpp"
+#include "Trace.hpp"
 
 using namespace std;
 
+/**
+ * @brief Build the 7-node lubricant transportation network
+ * @return Network with balances and edges of the example problem
+ */
+static NetworkFlow lubricantNetwork() {
+    NetworkFlow net(7);
+
+    // Set balances (1-indexed)
+    net.setBalance(1, 40);
+    net.setBalance(3, -20);
+    net.setBalance(4, 10);
+    net.setBalance(7, -30);
+
+    // Add edges
+    net.addEdge(1, 2, 5);
+    net.addEdge(1, 4, 2);
+    net.addEdge(1, 6, 8);
+    net.addEdge(2, 3, 10);
+    net.addEdge(3, 1, 3);
+    net.addEdge(3, 5, 5);
+    net.addEdge(3, 7, 7);
+    net.addEdge(4, 5, 6);
+    net.addEdge(5, 1, 12);
+    net.addEdge(5, 6, 12);
+    net.addEdge(5, 3, 5);
+    net.addEdge(6, 3, 9);
+    net.addEdge(6, 7, 20);
+
+    return net;
+}
+
+/**
+ * @brief Parse a solver backend name
+ * @param name Backend name given on the command line
+ * @param backend Receives the backend
+ * @return True if the name is known
+ */
+static bool parseBackend(const std::string &name, SolverBackend &backend) {
+    if (name == "cplex")
+        backend = SolverBackend::Cplex;
+    else if (name == "relax")
+        backend = SolverBackend::Relaxation;
+    else if (name == "scaling")
+        backend = SolverBackend::CapacityScaling;
+    else if (name == "cancel")
+        backend = SolverBackend::CycleCanceling;
+    else if (name == "transport")
+        backend = SolverBackend::Transportation;
+    else if (name == "simplex")
+        backend = SolverBackend::NetworkSimplex;
+    else
+        return false;
+    return true;
+}
+
+/**
+ * @brief Parse a node ordering name
+ * @param name Ordering name given on the command line
+ * @param order Receives the ordering
+ * @return True if the name is known
+ */
+static bool parseNodeOrder(const std::string &name, NodeOrder &order) {
+    if (name == "none")
+        order = NodeOrder::Original;
+    else if (name == "rcm")
+        order = NodeOrder::ReverseCuthillMcKee;
+    else if (name == "bfs")
+        order = NodeOrder::BreadthFirst;
+    else if (name == "hub")
+        order = NodeOrder::DegreeSorted;
+    else
+        return false;
+    return true;
+}
+
+/**
+ * @brief Parse a pricing rule name
+ * @param name Rule name given on the command line
+ * @param rule Receives the rule
+ * @return True if the name is known
+ */
+static bool parsePricing(const std::string &name, PricingRule &rule) {
+    if (name == "block")
+        rule = PricingRule::Block;
+    else if (name == "list")
+        rule = PricingRule::CandidateList;
+    else
+        return false;
+    return true;
+}
+
+/**
+ * @brief Load the contraction hierarchy of a network, building it if needed
+ * @param net Network whose topology the hierarchy must match
+ * @param path Hierarchy file; rewritten if missing, unreadable or stale
+ * @return Hierarchy of the network's topology
+ */
+static std::shared_ptr<const ContractionHierarchy>
+networkHierarchy(const NetworkFlow &net, const std::string &path) {
+    FlowGraph graph(net);
+    try {
+        auto stored = std::make_shared<const ContractionHierarchy>(
+            ContractionHierarchy::load(path));
+        if (stored->matches(graph))
+            return stored;
+    } catch (const std::runtime_error &) {
+        // Missing or damaged file, build a new one below
+    }
+
+    auto built = std::make_shared<const ContractionHierarchy>(graph);
+    built->save(path);
+    if (built->empty())
+        std::cerr << "Note: the network is too dense for a contraction "
+                  << "hierarchy, solving without it" << std::endl;
+    return built;
+}
+
+/**
+ * @brief Load a stored basis if it belongs to a network
+ * @param net Network to be solved
+ * @param path Basis file written by an earlier run
+ * @return Basis, or null if the file is missing, unreadable or stale
+ */
+static std::shared_ptr<const SimplexBasis>
+storedBasis(const NetworkFlow &net, const std::string &path) {
+    try {
+        auto stored = std::make_shared<const SimplexBasis>(
+            SimplexBasis::load(path));
+        if (stored->matches(net))
+            return stored;
+        std::cerr << "Note: the basis in " << path << " belongs to "
+                  << "another topology, starting without it" << std::endl;
+    } catch (const std::runtime_error &) {
+        // Missing or damaged file, start cold and write a new one
+    }
+    return nullptr;
+}
+
 /**
  * @brief Main function - Entry point for the lubricant transportation optimization
+ * @param argc Argument count
+ * @param argv Arguments: optional "-i <file>" instance to solve instead of
+ *             the built-in example (.min/.dimacs/.net or .csv), "-b <name>"
+ *             solver backend, "--pricing <rule>" entering arc rule of the
+ *             network simplex, "--no-shortcut" to always use it even on
+ *             acyclic networks, "--reorder <name>" node numbering of the
+ *             native backends, "--hierarchy <file>" contraction hierarchy
+ *             cache, "--basis <file>" optimal basis kept between runs,
+ *             "--trace <file>" Chrome trace of the read and solve phases,
+ *             "--counters" to print the algorithmic events of the solve,
+ *             "--metrics <file>" Prometheus metrics written after solving,
+ *             "--allocations" to print the allocations of each phase,
+ *             "--edge-store <file>" to keep the edges of the instance on
+ *             disk, "--memory-budget <MiB>" resident edge data,
+ *             "--sparse" and "-o <file>" outputs (format chosen by
+ *             extension)
  * @return 0 if successful, 1 if error occurred
  */
-int main() {
+int main(int argc, char *argv[]) {
     try {
-        NetworkFlow net(7);
-
-        // Set balances (1-indexed)
-        net.setBalance(1, 40);
-        net.setBalance(3, -20);
-        net.setBalance(4, 10);
-        net.setBalance(7, -30);
-
-        // Add edges
-        net.addEdge(1, 2, 5);
-        net.addEdge(1, 4, 2);
-        net.addEdge(1, 6, 8);
-        net.addEdge(2, 3, 10);
-        net.addEdge(3, 1, 3);
-        net.addEdge(3, 5, 5);
-        net.addEdge(3, 7, 7);
-        net.addEdge(4, 5, 6);
-        net.addEdge(5, 1, 12);
-        net.addEdge(5, 6, 12);
-        net.addEdge(5, 3, 5);
-        net.addEdge(6, 3, 9);
-        net.addEdge(6, 7, 20);
+        WriterOptions writerOptions;
+        SolveOptions solveOptions;
+        ReaderOptions readerOptions;
+        std::vector<std::string> outputs;
+        std::string inputPath;
+        std::string hierarchyPath;
+        std::string basisPath;
+        std::string tracePath;
+        std::string metricsPath;
+        bool printCounters = false;
+        bool printAllocations = false;
+
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--sparse") {
+                writerOptions.sparse = true;
+            } else if (arg == "--counters") {
+                printCounters = true;
+            } else if (arg == "--allocations") {
+                printAllocations = true;
+            } else if (arg == "--no-shortcut") {
+                solveOptions.acyclicShortcut = false;
+            } else if ((arg == "-i" || arg == "--input") && i + 1 < argc) {
+                inputPath = argv[++i];
+            } else if (arg == "--reorder" && i + 1 < argc &&
+                       parseNodeOrder(argv[i + 1], solveOptions.nodeOrder)) {
+                ++i;
+            } else if (arg == "--pricing" && i + 1 < argc &&
+                       parsePricing(argv[i + 1], solveOptions.pricing)) {
+                ++i;
+            } else if (arg == "--basis" && i + 1 < argc) {
+                basisPath = argv[++i];
+            } else if (arg == "--trace" && i + 1 < argc) {
+                tracePath = argv[++i];
+            } else if (arg == "--metrics" && i + 1 < argc) {
+                metricsPath = argv[++i];
+            } else if (arg == "--hierarchy" && i + 1 < argc) {
+                hierarchyPath = argv[++i];
+            } else if (arg == "--edge-store" && i + 1 < argc) {
+                readerOptions.edgeStorePath = argv[++i];
+            } else if (arg == "--memory-budget" && i + 1 < argc) {
+                readerOptions.memoryBudget = std::stoull(argv[++i]) << 20;
+            } else if ((arg == "-o" || arg == "--output") && i + 1 < argc) {
+                outputs.push_back(argv[++i]);
+            } else if ((arg == "-b" || arg == "--backend") && i + 1 < argc &&
+                       parseBackend(argv[i + 1], solveOptions.backend)) {
+                ++i;
+            } else {
+                std::cerr << "Usage: " << argv[0]
+                          << " [-i instance.min|instance.csv]"
+                          << " [-b cplex|relax|scaling|cancel|transport"
+                          << "|simplex]"
+                          << " [--pricing block|list] [--no-shortcut]"
+                          << " [--reorder none|rcm|bfs|hub]"
+                          << " [--hierarchy file.ch] [--basis file.basis]"
+                          << " [--trace file.json] [--counters]"
+                          << " [--metrics file.prom] [--allocations]"
+                          << " [--edge-store file] [--memory-budget MiB]"
+                          << " [--sparse]"
+                          << " [-o file.csv|file.json|file.bin]..."
+                          << std::endl;
+                return 1;
+            }
+        }
+
+        if (!tracePath.empty())
+            Trace::start();
+        if (printAllocations)
+            AllocationTracker::start();
+
+        NetworkFlow net = inputPath.empty()
+                              ? lubricantNetwork()
+                              : readInstance(inputPath,
+                                             instanceFormatFromPath(inputPath),
+                                             readerOptions);
 
         // Validate
-        if (std::string validation = net.validate(); validation != "valid") {
-            std::cerr << "Validation failed: " << validation << std::endl;
+        if (ValidationReport report = net.validate(); !report.valid()) {
+            std::cerr << "Validation failed:" << std::endl
+                      << report.summary() << std::endl;
             return 1;
+        } else if (!report.issues.empty()) {
+            std::cerr << "Validation warnings:" << std::endl
+                      << report.summary() << std::endl;
         }
 
+        if (!hierarchyPath.empty())
+            solveOptions.hierarchy = networkHierarchy(net, hierarchyPath);
+        if (!basisPath.empty())
+            solveOptions.initialBasis = storedBasis(net, basisPath);
+
         // Solve
-        Solution sol = net.solve();
+        Solution sol = net.solve(solveOptions);
+        if (!basisPath.empty() && sol.basis)
+            sol.basis->save(basisPath);
+        if (!tracePath.empty()) {
+            Trace::stop();
+            Trace::write(tracePath);
+        }
+        if (!metricsPath.empty())
+            Metrics::write(metricsPath);
 
         if (sol.solved) {
             std::cout << "Solution Status: " << sol.status << std::endl;
             std::cout << "Total Minimum Cost: " << sol.totalCost << std::endl << std::endl;
 
+            if (printCounters) {
+                std::cout << "Counters:" << std::endl;
+                for (size_t k = 0; k < COUNTER_KINDS; ++k) {
+                    Counter c = static_cast<Counter>(k);
+                    std::cout << "  " << SolveCounters::name(c) << ": "
+                              << sol.counters[c] << std::endl;
+                }
+                std::cout << std::endl;
+            }
+
+            if (printAllocations) {
+                std::cout << "Allocations (calls, bytes):" << std::endl;
+                for (const PhaseAllocations &phase : sol.allocations) {
+                    std::cout << "  " << phase.phase << ": heap ";
+                    if (AllocationTracker::HEAP_HOOKED)
+                        std::cout << phase.heapCalls << ", "
+                                  << phase.heapBytes;
+                    else
+                        std::cout << "tracking disabled";
+                    std::cout << "; arena " << phase.arenaCalls << ", "
+                              << phase.arenaBytes << std::endl;
+                }
+                std::cout << std::endl;
+            }
+
+            // Cost of the first edge of each used node pair, in one sweep
+            std::map<std::pair<int, int>, double> costs;
+            net.sweepEdges([&](const EdgeBlock &block) {
+                for (size_t k = 0; k < block.count; ++k) {
+                    std::pair<int, int> key(block.from[k], block.to[k]);
+                    if (sol.flows.count(key))
+                        costs.emplace(key, block.cost[k]);
+                }
+            });
+
             std::cout << "Flow Assignment:" << std::endl;
             for (const auto& [edge, flow] : sol.flows) {
                 int i = edge.first;
                 int j = edge.second;
-                double cost = 0;
-
-                // Find cost
-                for (const auto& e : net.getEdges()) {
-                    if (e.from == i && e.to == j) {
-                        cost = e.cost;
-                        break;
-                    }
-                }
+                double cost = costs[edge];
                 std::cout << "  " << i << " → " << j
                           << " : " << flow
                           << " units (cost/unit: " << cost
                           << ", total: " << flow * cost << ")" << std::endl;
             }
+
+            // Export
+            for (const auto& path : outputs) {
+                makeSolutionWriter(formatFromPath(path), writerOptions)
+                    ->write(net, sol, path);
+            }
         } else {
             std::cerr << "Failed to solve: " << sol.status << std::endl;
         }